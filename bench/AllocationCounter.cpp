@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Linked only into the benchmark build of the interpreter.
+ * Replaces the global operator new to count heap allocations, the totals
+ * are written at exit to the file named by LOX_ALLOC_REPORT for the harness
+ */
+
+static unsigned long allocations = 0;
+static unsigned long allocatedBytes = 0;
+
+static void* countedAllocation(std::size_t size)
+{
+    allocations++;
+    allocatedBytes += size;
+
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new(std::size_t size)
+{
+    return countedAllocation(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocation(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t size) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t size) noexcept
+{
+    std::free(memory);
+}
+
+class AllocationReport
+{
+    public:
+        ~AllocationReport()
+        {
+            const char* path = std::getenv("LOX_ALLOC_REPORT");
+            if (path == nullptr) {
+                return;
+            }
+
+            // Taken before fopen allocates
+            unsigned long count = allocations;
+            unsigned long bytes = allocatedBytes;
+
+            FILE* file = std::fopen(path, "w");
+            if (file != nullptr) {
+                std::fprintf(file, "%lu %lu\n", count, bytes);
+                std::fclose(file);
+            }
+        }
+};
+
+// Static destructors also run when the interpreter leaves through exit()
+static AllocationReport report;
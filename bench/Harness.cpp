@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Benchmark harness
+ * Runs every script N times with the given interpreter and reports
+ * median and p95 wall time, peak RSS and heap allocations per script.
+ * Results are also written as JSON so different builds can be compared
+ *
+ * Usage: bench-harness [--runs=N] [--json=path] [--arg=<interpreter option>]...
+ *                      <interpreter> <script>...
+ */
+
+struct Run
+{
+    double wallMs;
+    long maxRssKb;
+    unsigned long allocations;
+    unsigned long allocatedBytes;
+    bool failed;
+};
+
+struct Result
+{
+    std::string name;
+    double medianMs;
+    double p95Ms;
+    double minMs;
+    long peakRssKb;
+    unsigned long allocations;
+    unsigned long allocatedBytes;
+    bool failed;
+};
+
+void usage()
+{
+    std::cerr << "Usage: bench-harness [--runs=N] [--json=path] [--arg=<option>]... "
+              << "<interpreter> <script>..." << std::endl;
+    exit(1);
+}
+
+Run runOnce(std::string interpreter, std::vector<std::string> args, std::string script)
+{
+    Run run = { 0, 0, 0, 0, false };
+
+    std::string reportPath = "/tmp/lox-bench-" + std::to_string(getpid()) + ".alloc";
+    std::remove(reportPath.c_str());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Script output is not part of the measurement
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        dup2(devNull, STDERR_FILENO);
+
+        setenv("LOX_ALLOC_REPORT", reportPath.c_str(), 1);
+
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(interpreter.c_str()));
+        for (std::string& arg: args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(const_cast<char*>(script.c_str()));
+        argv.push_back(nullptr);
+
+        execv(interpreter.c_str(), argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    run.wallMs = elapsed.count();
+    run.maxRssKb = usage.ru_maxrss;
+    run.failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+
+    std::ifstream report(reportPath);
+    report >> run.allocations >> run.allocatedBytes;
+    std::remove(reportPath.c_str());
+
+    return run;
+}
+
+// Nearest rank percentile of sorted values
+double percentile(std::vector<double>& sorted, double p)
+{
+    std::size_t rank = (std::size_t)(p / 100.0 * sorted.size() + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+std::string baseName(std::string path)
+{
+    std::size_t slash = path.find_last_of('/');
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    std::size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+Result measure(std::string interpreter, std::vector<std::string> args, std::string script, int runs)
+{
+    Result result;
+    result.name = baseName(script);
+    result.peakRssKb = 0;
+    result.failed = false;
+
+    std::vector<double> times;
+    std::vector<unsigned long> allocations;
+    std::vector<unsigned long> allocatedBytes;
+
+    for (int i = 0; i < runs; i++) {
+        Run run = runOnce(interpreter, args, script);
+
+        times.push_back(run.wallMs);
+        allocations.push_back(run.allocations);
+        allocatedBytes.push_back(run.allocatedBytes);
+
+        result.peakRssKb = std::max(result.peakRssKb, run.maxRssKb);
+        result.failed = result.failed || run.failed;
+    }
+
+    std::sort(times.begin(), times.end());
+    std::sort(allocations.begin(), allocations.end());
+    std::sort(allocatedBytes.begin(), allocatedBytes.end());
+
+    result.medianMs = percentile(times, 50);
+    result.p95Ms = percentile(times, 95);
+    result.minMs = times.front();
+    result.allocations = allocations[allocations.size() / 2];
+    result.allocatedBytes = allocatedBytes[allocatedBytes.size() / 2];
+
+    return result;
+}
+
+std::string toJson(std::string interpreter, std::vector<std::string> args, int runs, std::vector<Result>& results)
+{
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+
+    json << "{\n";
+    json << "  \"interpreter\": \"" << interpreter << "\",\n";
+    json << "  \"args\": [";
+    for (std::size_t i = 0; i < args.size(); i++) {
+        json << (i > 0 ? ", " : "") << "\"" << args[i] << "\"";
+    }
+    json << "],\n";
+    json << "  \"runs\": " << runs << ",\n";
+    json << "  \"benchmarks\": [\n";
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        Result& result = results[i];
+
+        json << "    {"
+             << "\"name\": \"" << result.name << "\", "
+             << "\"median_ms\": " << result.medianMs << ", "
+             << "\"p95_ms\": " << result.p95Ms << ", "
+             << "\"min_ms\": " << result.minMs << ", "
+             << "\"peak_rss_kb\": " << result.peakRssKb << ", "
+             << "\"allocations\": " << result.allocations << ", "
+             << "\"allocated_bytes\": " << result.allocatedBytes << ", "
+             << "\"failed\": " << (result.failed ? "true" : "false")
+             << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+
+    json << "  ]\n";
+    json << "}\n";
+
+    return json.str();
+}
+
+int main(int argc, char** argv)
+{
+    int runs = 10;
+    std::string jsonPath;
+    std::vector<std::string> args;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg.compare(0, 7, "--runs=") == 0) {
+            runs = ::atoi(arg.c_str() + 7);
+        } else if (arg.compare(0, 7, "--json=") == 0) {
+            jsonPath = arg.substr(7);
+        } else if (arg.compare(0, 6, "--arg=") == 0) {
+            if (arg.size() > 6) {
+                args.push_back(arg.substr(6));
+            }
+        } else if (arg.compare(0, 2, "--") == 0) {
+            usage();
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (runs < 1 || positional.size() < 2) {
+        usage();
+    }
+
+    std::string interpreter = positional[0];
+    std::vector<Result> results;
+
+    std::cout << std::left << std::setw(12) << "benchmark"
+              << std::right << std::setw(12) << "median ms"
+              << std::setw(12) << "p95 ms"
+              << std::setw(14) << "peak RSS KB"
+              << std::setw(14) << "allocations" << std::endl;
+
+    for (std::size_t i = 1; i < positional.size(); i++) {
+        Result result = measure(interpreter, args, positional[i], runs);
+        results.push_back(result);
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::left << std::setw(12) << result.name
+                  << std::right << std::setw(12) << result.medianMs
+                  << std::setw(12) << result.p95Ms
+                  << std::setw(14) << result.peakRssKb
+                  << std::setw(14) << result.allocations
+                  << (result.failed ? "  FAILED" : "") << std::endl;
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        json << toJson(interpreter, args, runs, results);
+    }
+
+    return 0;
+}
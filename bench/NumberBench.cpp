@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "./../include/Interpreter/NumberFormatter.h"
+
+/**
+ * Number formatting benchmark
+ * Formats the same numbers with the previous std::to_string based path
+ * and with NumberFormatter, and reports the best time per number of each
+ */
+
+const int RUNS = 5;
+const std::size_t COUNT = 1000000;
+
+// What print showed before NumberFormatter, six decimals with trailing zeros removed
+std::string formatWithToString(double number)
+{
+    std::string text = std::to_string(number);
+
+    if (text.find('.') != std::string::npos) {
+        text.erase(text.find_last_not_of('0') + 1);
+
+        if (text.back() == '.') {
+            text.pop_back();
+        }
+    }
+
+    return text;
+}
+
+// Counters, like most numbers printed by scripts, then fractions of every magnitude
+std::vector<double> generateNumbers()
+{
+    std::mt19937_64 random(42);
+    std::vector<double> numbers;
+    numbers.reserve(COUNT);
+
+    for (std::size_t i = 0; i < COUNT / 2; i++) {
+        numbers.push_back((double)i);
+    }
+
+    std::uniform_real_distribution<double> fraction(0, 1);
+    std::uniform_int_distribution<int> magnitude(-8, 12);
+
+    while (numbers.size() < COUNT) {
+        numbers.push_back(fraction(random) * std::pow(10.0, magnitude(random)));
+    }
+
+    return numbers;
+}
+
+template <class Format>
+double bestNanoseconds(const std::vector<double>& numbers, Format format, std::size_t* checksum)
+{
+    double best = 0;
+
+    for (int i = 0; i < RUNS; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // Summing lengths keeps the calls from being optimized away
+        std::size_t length = 0;
+        for (double number: numbers) {
+            length += format(number).size();
+        }
+
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+        double perNumber = elapsed.count() / numbers.size();
+        if (i == 0 || perNumber < best) {
+            best = perNumber;
+        }
+
+        *checksum = length;
+    }
+
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<double> numbers = generateNumbers();
+    std::size_t legacyLength, shortestLength;
+
+    double legacy = bestNanoseconds(numbers, formatWithToString, &legacyLength);
+    double shortest = bestNanoseconds(
+        numbers,
+        [](double number) { return NumberFormatter::format(number); },
+        &shortestLength
+    );
+
+    std::cout << "formatted " << numbers.size() << " numbers, best of " << RUNS << std::endl;
+    std::cout << "std::to_string: " << legacy << " ns/number, " << legacyLength << " chars" << std::endl;
+    std::cout << "NumberFormatter: " << shortest << " ns/number, " << shortestLength << " chars" << std::endl;
+
+    return 0;
+}
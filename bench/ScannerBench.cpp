@@ -0,0 +1,79 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "./../include/Lox.h"
+
+/**
+ * Scanner throughput benchmark
+ * Scans the given file, or a generated multi megabyte config like
+ * source, several times and reports the best throughput in MB/s
+ */
+
+const int RUNS = 5;
+const std::size_t GENERATED_SIZE = 16 * 1024 * 1024;
+
+std::string* generateSource()
+{
+    std::string entry =
+        "// service entry\n"
+        "var service_name = \"frontend-cache\";\n"
+        "var replicas = 12;\n"
+        "var timeout_seconds = 2.5;\n"
+        "fun weight(load) {\n"
+        "    if (load >= 0.75 and replicas > 4) return load * 2;\n"
+        "    return load / 3 + 1;\n"
+        "}\n";
+
+    std::string* source = new std::string();
+    source->reserve(GENERATED_SIZE + entry.size());
+
+    while (source->size() < GENERATED_SIZE) {
+        *source += entry;
+    }
+
+    return source;
+}
+
+int main(int argc, char** argv)
+{
+    Source* source;
+
+    if (argc > 1) {
+        // Mapped like the interpreter loads scripts
+        std::string error;
+        source = Source::load(argv[1], &error);
+
+        if (source == nullptr) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+    } else {
+        source = new Source(std::move(*generateSource()));
+    }
+
+    double megabytes = source->length() / (1024.0 * 1024.0);
+    double best = 0;
+    std::size_t tokenCount = 0;
+
+    for (int i = 0; i < RUNS; i++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        Scanner scanner(source);
+        std::unique_ptr<std::vector<Token>> tokens(scanner.scanTokens());
+        tokenCount = tokens->size();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double throughput = megabytes / elapsed.count();
+        if (throughput > best) {
+            best = throughput;
+        }
+    }
+
+    std::cout << "scanned " << megabytes << " MB, " << tokenCount << " tokens" << std::endl;
+    std::cout << "best of " << RUNS << ": " << best << " MB/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "./../Parser/Expression/ExpressionHeaders.h"
+#include "./../Parser/Stmt/StmtHeaders.h"
+#include "./../Interpreter/Interpreter.h"
+#include "./CompiledBlock.h"
+
+/**
+ * @brief Converts resolved syntax trees into trees of pre-bound callables,
+ * once per program. Each compiled node captured its operands, operator
+ * and variable slot, so running it is a direct call instead of the
+ * accept and visit double dispatch of the Interpreter.
+ * Selected with --closures, compiled code runs on the Interpreter's
+ * frames and heap, so functions and classes behave the same
+ *
+ */
+class ClosureCompiler:
+    public Expr::Visitor<std::string*>,
+    public Stmt::Visitor<void*>
+{
+    private:
+        Interpreter* interpreter;
+
+        // Result of the last visited node
+        CompiledExpr compiledExpr;
+        CompiledStmt compiledStmt;
+
+    public:
+        ClosureCompiler(Interpreter* interpreter);
+
+        /**
+         * @brief Compiles and runs already resolved statements
+         *
+         * @param statements
+         */
+        void interpret(NodeList<Stmt::Stmt*>* statements);
+
+    public:
+        virtual std::string* visitAssignExpr(Expr::Assign* expr) override;
+        virtual std::string* visitBinaryExpr(Expr::Binary* expr) override;
+        virtual std::string* visitCallExpr(Expr::Call* expr) override;
+        virtual std::string* visitGetExpr(Expr::Get* expr) override;
+        virtual std::string* visitGroupingExpr(Expr::Grouping* expr) override;
+        virtual std::string* visitLiteralExpr(Expr::Literal* expr) override;
+        virtual std::string* visitLogicalExpr(Expr::Logical* expr) override;
+        virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
+        virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
+        virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual std::string* visitThisExpr(Expr::This* expr) override;
+
+    public:
+        virtual void* visitBlockStmt(Stmt::Block* stmt) override;
+        virtual void* visitClassStmt(Stmt::Class* stmt) override;
+        virtual void* visitExpressionStmt(Stmt::Expression* stmt) override;
+        virtual void* visitFunctionStmt(Stmt::Function* stmt) override;
+        virtual void* visitIfStmt(Stmt::If* stmt) override;
+        virtual void* visitPrintStmt(Stmt::Print* stmt) override;
+        virtual void* visitReturnStmt(Stmt::Return* stmt) override;
+        virtual void* visitVarStmt(Stmt::Var* stmt) override;
+        virtual void* visitWhileStmt(Stmt::While* stmt) override;
+
+    private:
+        CompiledExpr compile(Expr::Expr* expr);
+        CompiledStmt compile(Stmt::Stmt* stmt);
+        CompiledBlock* compile(NodeList<Stmt::Stmt*>* statements);
+        std::vector<CompiledExpr> compile(NodeList<Expr::Expr*>* arguments);
+
+        // Chain of additions, eg: a + b + c, run by one closure so that
+        // a concatenation allocates a single string, see Interpreter::concatenateChain()
+        CompiledExpr compileAdditionChain(Expr::Binary* expr);
+
+    private:
+        // Right operand of an operator, rooting the left one if it is an object
+        static Value evaluateRight(Interpreter* interpreter, Value left, const CompiledExpr& right);
+
+        // Evaluates the arguements onto the stack, then calls the callee
+        // unless the call is left to the returning function as a tail call
+        static Value call(
+            Interpreter* interpreter,
+            Expr::Call* expr,
+            Value callee,
+            Value* receiver,
+            const std::vector<CompiledExpr>& arguments
+        );
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "./../Parser/Stmt/Stmt.h"
+#include "./../Interpreter/Value.h"
+
+// Expression compiled into a callable, with its operands, slots and
+// operator already bound so evaluating it is a direct call
+typedef std::function<Value()> CompiledExpr;
+typedef std::function<Stmt::Completion()> CompiledStmt;
+
+/**
+ * @brief Statements of a compiled program, block or function body.
+ * Like syntax trees they live for the whole session,
+ * since functions keep running their compiled bodies
+ *
+ */
+class CompiledBlock
+{
+    public:
+        std::vector<CompiledStmt> statements;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+#include "./Value.h"
+
+/**
+ * @brief Arguements of a call, viewed where the caller evaluated them.
+ * Usually that is the top of the interpreter's or the VM's value stack,
+ * so a call never copies them into a container of its own.
+ * Values are only valid until the call returns
+ *
+ */
+class ArgumentSpan
+{
+    public:
+        Value* values;
+        std::size_t count;
+
+    public:
+        ArgumentSpan(Value* values, std::size_t count) : values(values), count(count) {}
+
+    public:
+        Value* begin() const { return values; }
+        Value* end() const { return values + count; }
+
+        std::size_t size() const { return count; }
+
+        Value& at(std::size_t index) const { return values[index]; }
+        Value& operator[](std::size_t index) const { return values[index]; }
+};
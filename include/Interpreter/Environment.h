@@ -2,64 +2,90 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "./../Scanner/Token.h"
 #include "./RuntimeError.h"
+#include "./Value.h"
+#include "./HeapObject.h"
+#include "./LoxString.h"
 
 #include "./../Native/Clock.h"
+#include "./../Native/Flush.h"
 
-class Environment
+/**
+ * @brief Global variables of the interpreter. Locals live in the frames
+ * of the interpreter's stack instead, since the resolver numbered them
+ *
+ */
+class Environment: public HeapObject
 {
     private:
-        std::unordered_map<std::string, void*>* values;
+        // Interned name to slot table, globals are not tracked by the resolver
+        std::unordered_map<LoxString*, int>* globalSlots;
 
-    public:
-        // Reference to Environment of parent block
-        Environment* enclosing;
+        // Whether each global slot holds a definition yet
+        // Slots are reserved on first reference, which can come before
+        // the definition eg: functions calling later declared functions
+        std::vector<bool>* defined;
+
+        // Variables indexed by globalSlot()
+        std::vector<Value> slots;
 
     public:
         Environment();
-        Environment(Environment* enclosing);
+        virtual ~Environment();
+
+    public:
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
 
     public:
         /**
-         * @brief used to define a variable when Var keyword is used
+         * @brief used to define a global variable when Var keyword is used
          * 
          * @param name 
          * @param value 
          */
-        void define(std::string* name, void* value);
+        void define(LoxString* name, Value value);
+
+        /**
+         * @brief Returns the slot of a global name, reserving an undefined
+         * slot on first use. A name keeps its slot for the whole session
+         * so call sites can cache it, even across REPL redefinitions
+         * 
+         * @param name 
+         * @return int 
+         */
+        int globalSlot(LoxString* name);
 
         /**
-         * @brief Used to assign new value to identifier 
+         * @brief Used to assign new value to global identifier 
          * once it is already defined in memory.
          * Assignment is not allowed to create new variable
          * 
          * @param name 
+         * @param slot cached result of globalSlot()
          * @param value 
          */
-        void assign(Token* name, void* value);
+        void assign(Token* name, int slot, Value value);
 
         /**
-         * @brief Searches dynamically at runtime for the variable definition
+         * @brief Reads a global, throws if the slot has no definition yet
          * 
          * @param name 
-         * @return void* 
+         * @param slot cached result of globalSlot()
+         * @return Value 
          */
-        void* get(Token* name);
+        Value get(Token* name, int slot);
 
-    public:
         /**
-         * @brief Searches the variable based on distance obtained static analyis in resolver
+         * @brief Reads a global without throwing, for callers that cannot unwind
          * 
-         * @param distance 
-         * @param name 
-         * @return void* 
+         * @param slot cached result of globalSlot()
+         * @param value set to the variable when it is defined
+         * @return bool false if the slot has no definition yet
          */
-        void* getAt(int distance, std::string name);
-        void assignAt(int distance, Token* name, void* value);
-
-    private:    
-        Environment* ancestor(int distance);
-};
\ No newline at end of file
+        bool tryGet(int slot, Value* value);
+};
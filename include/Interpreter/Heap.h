@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "./HeapObject.h"
+#include "./Value.h"
+
+class Heap;
+
+/**
+ * @brief Implemented by the execution engine to report what it can
+ * still reach, eg: globals and the live part of its stack
+ *
+ */
+class GcRootProvider
+{
+    public:
+        virtual void markRoots(Heap* heap) = 0;
+};
+
+/**
+ * @brief Precise mark-sweep garbage collector for runtime objects.
+ * Every object allocated while running a program is passed to track().
+ * A collection is triggered from track() once the bytes allocated since
+ * the last collection exceed nextCollection.
+ * Objects growing later are measured again by grew(), and every reached
+ * object is measured again while marking, eg: ropes flattened in place
+ *
+ */
+class Heap
+{
+    public:
+        // After a collection, next one is triggered at live bytes * growthFactor
+        double growthFactor;
+        // Lower bound for the collection threshold
+        std::size_t minimumThreshold;
+        // Whether statistics are reported at exit, set by --gc-stats
+        bool reportStats;
+
+    private:
+        HeapObject* objects;
+        std::vector<HeapObject*>* grayStack;
+
+        // Values held by C++ locals of the interpreter while it evaluates
+        // other expressions, which can trigger a collection
+        std::vector<Value>* tempRoots;
+
+        GcRootProvider* rootProvider;
+
+        unsigned int epoch;
+        std::size_t bytesAllocated;
+        std::size_t nextCollection;
+
+    private:
+        // Statistics reported by --gc-stats
+        unsigned long collections;
+        unsigned long objectsFreed;
+        std::size_t bytesReclaimed;
+        double totalPauseMs;
+        double maxPauseMs;
+
+    public:
+        Heap();
+
+    public:
+        /**
+         * @brief Registers a newly allocated object with the collector
+         * A collection may run before the object is linked, so the new
+         * object itself is never swept by it
+         *
+         * @param object
+         * @return T* the same object
+         */
+        template <class T>
+        T* track(T* object)
+        {
+            trackObject(object);
+            return object;
+        }
+
+        /**
+         * @brief Counts what a tracked object allocated since it was last
+         * measured, eg: an instance spilling its fields. Never collects,
+         * since the object may not be rooted at that point
+         *
+         * @param object
+         */
+        void grew(HeapObject* object);
+
+        void setRootProvider(GcRootProvider* rootProvider);
+
+        void pushRoot(Value value);
+        void popRoots(std::size_t count);
+        // Drops all temporary roots, used once a runtime error unwound the interpreter
+        void resetRoots();
+
+    public:
+        void markValue(Value value);
+        void markObject(HeapObject* object);
+
+        void collect();
+
+        void printStats(std::ostream& os);
+
+    private:
+        void trackObject(HeapObject* object);
+        void traceReferences();
+        void sweep();
+};
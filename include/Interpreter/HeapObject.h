@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+class Heap;
+
+/**
+ * @brief Base class of everything the garbage collector can free.
+ * Heap links tracked objects into a list and walks it when sweeping
+ *
+ */
+class HeapObject
+{
+    public:
+        // Equal to Heap epoch when reached in the current collection
+        // Objects never tracked by the Heap are simply never swept
+        unsigned int markEpoch;
+
+        // Bytes counted against the heap when the object was last measured
+        // Zero for objects that were never tracked
+        std::size_t trackedBytes;
+
+        // Next object in Heap's list of tracked objects
+        HeapObject* next;
+
+    public:
+        HeapObject();
+        virtual ~HeapObject();
+
+    public:
+        /**
+         * @brief Marks every object directly referenced by this object
+         *
+         * @param heap
+         */
+        virtual void trace(Heap* heap);
+
+        /**
+         * @brief Approximate number of bytes owned by the object
+         *
+         * @return std::size_t
+         */
+        virtual std::size_t size() = 0;
+};
@@ -7,19 +7,58 @@
 #include "./../Lox.h"
 #include "./RuntimeHeaders.h"
 
+#include "./../Closure/CompiledBlock.h"
+
+class LoxFunction;
+class LoxInstance;
+class Jit;
+
 class Interpreter: 
-    public Expr::Visitor<std::string*>,
-    public Stmt::Visitor<void*>
+    public Expr::Visitor<Value>,
+    public Stmt::Visitor<Stmt::Completion>,
+    public GcRootProvider
 {
+    public:
+        // Local slots of every active call
+        static const int STACK_MAX = 64 * 1024;
+
     public:
         // Holds fixed ref to outermost env.
         Environment* globals;
-        // Tracks the current environment, 
-        // Changes when entering and exiting scope
-        Environment* environment;
 
-        // Associates each syntax tree node with its resolved data
-        std::unordered_map<Expr::Expr*, int>* locals;
+        // Locals live on a stack of frames reused by every call, each
+        // frame starts right after the live locals of its caller.
+        // Top level blocks keep their locals at the bottom of the stack
+        Value* stack;
+        Value* stackTop;
+        Value* frame;
+
+        // Function running in the current frame, nullptr for top level code
+        LoxFunction* closure;
+
+        // Garbage collected storage for every runtime object
+        Heap* heap;
+
+        // Value of the last executed return statement,
+        // read by the function call that the return completed
+        Value returnValue;
+
+        // Compiles hot functions to machine code
+        Jit* jit;
+
+    // Closure compiled code runs on this interpreter's state and helpers
+    friend class ClosureCompiler;
+
+    private:
+        // Functions of the calls suspended by the running one
+        std::vector<LoxFunction*>* callers;
+
+        // Tail call left by the last return, run by callFunction
+        // in the returning frame, tailFunction is nullptr if there is none
+        LoxFunction* tailFunction;
+        bool tailHasReceiver;
+        Value tailReceiver;
+        std::vector<Value>* tailArguments;
 
     public:
         Interpreter();
@@ -27,65 +66,214 @@ class Interpreter:
     // Semantics handling for Expression and Statements
     // Expressions Handling
     public:
-        virtual std::string* visitLiteralExpr(Expr::Literal* expr) override;
-        virtual std::string* visitGroupingExpr(Expr::Grouping* expr) override;
-        virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
-        virtual std::string* visitBinaryExpr(Expr::Binary* expr) override;
-        virtual std::string* visitGetExpr(Expr::Get* expr) override;
-        virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
-        virtual std::string* visitAssignExpr(Expr::Assign* expr) override;
-        virtual std::string* visitLogicalExpr(Expr::Logical* expr) override;
-        virtual std::string* visitCallExpr(Expr::Call* expr) override;
-        virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual Value visitLiteralExpr(Expr::Literal* expr) override;
+        virtual Value visitGroupingExpr(Expr::Grouping* expr) override;
+        virtual Value visitUnaryExpr(Expr::Unary* expr) override;
+        virtual Value visitBinaryExpr(Expr::Binary* expr) override;
+        virtual Value visitGetExpr(Expr::Get* expr) override;
+        virtual Value visitVariableExpr(Expr::Variable* expr) override;
+        virtual Value visitAssignExpr(Expr::Assign* expr) override;
+        virtual Value visitLogicalExpr(Expr::Logical* expr) override;
+        virtual Value visitCallExpr(Expr::Call* expr) override;
+        virtual Value visitSetExpr(Expr::Set* expr) override;
+        virtual Value visitThisExpr(Expr::This* expr) override;
 
     // Statements Handling
     public:
-        virtual void* visitClassStmt(Stmt::Class* stmt) override;
-        virtual void* visitPrintStmt(Stmt::Print* stmt) override;
-        virtual void* visitExpressionStmt(Stmt::Expression* stmt) override;
-        virtual void* visitVarStmt(Stmt::Var* stmt) override;
-        virtual void* visitBlockStmt(Stmt::Block* stmt) override;
-        virtual void* visitIfStmt(Stmt::If* stmt) override;
-        virtual void* visitWhileStmt(Stmt::While* stmt) override;
-        virtual void* visitFunctionStmt(Stmt::Function* stmt) override;
-        virtual void* visitReturnStmt(Stmt::Return* stmt) override;
+        virtual Stmt::Completion visitClassStmt(Stmt::Class* stmt) override;
+        virtual Stmt::Completion visitPrintStmt(Stmt::Print* stmt) override;
+        virtual Stmt::Completion visitExpressionStmt(Stmt::Expression* stmt) override;
+        virtual Stmt::Completion visitVarStmt(Stmt::Var* stmt) override;
+        virtual Stmt::Completion visitBlockStmt(Stmt::Block* stmt) override;
+        virtual Stmt::Completion visitIfStmt(Stmt::If* stmt) override;
+        virtual Stmt::Completion visitWhileStmt(Stmt::While* stmt) override;
+        virtual Stmt::Completion visitFunctionStmt(Stmt::Function* stmt) override;
+        virtual Stmt::Completion visitReturnStmt(Stmt::Return* stmt) override;
+
+    private:
+        /**
+         * @brief Rewrites a node into the specialization fitting
+         * the operand types of its first evaluation
+         */
+        void specialize(Expr::Binary* expr, Value left, Value right);
+        void specialize(Expr::Unary* expr, Value right);
+        void specialize(Expr::Logical* expr, Value left);
+
+        // Generic operations, checking operand types on every evaluation
+        Value binaryOperation(Expr::Binary* expr, Value left, Value right);
+        Value unaryOperation(Expr::Unary* expr, Value right);
+
+    private:
+        // Addition of a string and any value, throws if neither is a string
+        Value concatenate(Token* operator_, Value left, Value right);
+
+        /**
+         * @brief Chain of additions making a string, eg: "x = " + x + "\n"
+         * Evaluated left to right like one node at a time, but the text is
+         * collected in a builder so the chain allocates a single string
+         */
+        Value concatenateChain(Expr::Binary* expr);
+        // Sum of the chain's operands so far, the text after it is in builder
+        Value addChainOperands(Expr::Binary* expr, std::string* builder);
+
+        /**
+         * @brief Adds the next operand of a chain. Numbers are summed until
+         * an operand is a string, from then on sum is the string starting
+         * the result and the text of later operands is appended to builder
+         * 
+         * @param operator_ reported if the operands cant be added
+         * @param sum 
+         * @param builder 
+         * @param operand 
+         */
+        void addOperand(Token* operator_, Value* sum, std::string* builder, Value operand);
+        // Result of a chain, sum has to be rooted by the caller
+        Value finishAddition(Value sum, std::string* builder);
+
+    private:
+        /**
+         * @brief Method call site, eg: object.method(arguements)
+         * The method is found through the inline cache of the call
+         * and called without creating a bound method
+         */
+        Value invokeMethod(Expr::Call* expr);
+
+        // Looks the method up in the class, remembering it for the receiver's shape
+        LoxFunction* findMethod(Expr::Call* expr, LoxInstance* instance);
+
+        /**
+         * @brief Callee of a method call site, found through its inline cache
+         * 
+         * @param expr 
+         * @param object receiver
+         * @param callee set to the method, or to the field shadowing it
+         * @return bool whether callee is a method expecting the receiver
+         */
+        bool methodCallee(Expr::Call* expr, Value object, Value* callee);
+
+        // Evaluates the arguements onto the stack, then calls the callee
+        Value call(Expr::Call* expr, Value callee, Value* receiver);
+        // Pushes a receiver or an arguement of a call
+        void pushArgument(Token* paren, Value value);
+
+        // Property read, binding methods to the instance
+        Value getProperty(Token* name, Value object);
 
     private:
         // Resolver utilities
-        void* lookUpVariable(Token* name, Expr::Expr* expr);
-        void* getAt(int distance, std::string name);
-        Environment* ancestor(int distance);
+        Value lookUpVariable(Expr::Variable* expr);
+
+        // Reads and writes a variable the resolver found in a frame or closure
+        Value getLocal(Expr::VariableKind kind, int slot);
+        void assignLocal(Expr::VariableKind kind, int slot, Value value);
+
+        /**
+         * @brief Binds a declaration where the resolver placed it.
+         * Globals are bound by name, locals in the next slot of the
+         * frame, inside a cell when closures capture them
+         */
+        void define(Token* name, Expr::VariableKind kind, Value value);
+
+        /**
+         * @brief Closure of the declaration, capturing cells of the current frame and closure
+         * 
+         * @param declaration 
+         * @param isInitializer 
+         * @param compiled body compiled by the ClosureCompiler, nullptr to walk the tree
+         * @return LoxFunction* 
+         */
+        LoxFunction* makeFunction(Stmt::Function* declaration, bool isInitializer, CompiledBlock* compiled);
+
+        // Makes the closure of a function declaration and binds it to its name
+        void defineFunction(Stmt::Function* declaration, CompiledBlock* compiled);
+
+        // Makes a class and binds it, bodies holds compiled methods, nullptr to walk the tree
+        void defineClass(Stmt::Class* stmt, std::vector<CompiledBlock*>* bodies);
+
+        // Pushes the cell of a captured declaration before its value is made, nullptr otherwise
+        LoxUpvalue* declareCell(Expr::VariableKind kind);
 
     private:
         // Evaluation of Every expression is done in post order
-        std::string* evaluate(Expr::Expr* expr);
-        std::string* isTruthy(std::string* object);
+        Value evaluate(Expr::Expr* expr);
+        bool isTruthy(Value object);
 
     public:
-        void execute(Stmt::Stmt* stmt);
-        void executeBlock(std::vector<Stmt::Stmt*>* statements, Environment* environment);
+        Stmt::Completion execute(Stmt::Stmt* stmt);
+        // Statements of a block, whose locals are popped once it ends
+        Stmt::Completion executeBlock(NodeList<Stmt::Stmt*>* statements);
+        Stmt::Completion executeBlock(CompiledBlock* block);
+        // Statements of a block declaring no locals, eg: most loop bodies
+        Stmt::Completion executeStatements(NodeList<Stmt::Stmt*>* statements);
+        Stmt::Completion executeStatements(CompiledBlock* block);
+
+        /**
+         * @brief Runs the function's body in a new frame holding
+         * the receiver, if any, and the arguements.
+         * Receiver and arguements pushed last on the stack become
+         * the frame where they are, without being copied
+         * 
+         * @param function 
+         * @param receiver nullptr unless function is a method
+         * @param arguments 
+         * @return Value 
+         */
+        Value callFunction(LoxFunction* function, Value* receiver, ArgumentSpan arguments);
+
+        // Lox calls in progress, tail calls reuse the frame of their caller
+        int callDepth();
+
+        /**
+         * @brief Arity check and call of an evaluated callee.
+         * Arguements and receiver have to be rooted by the caller
+         * 
+         * @param paren reported on errors
+         * @param callee 
+         * @param receiver nullptr unless callee is a method
+         * @param arguements 
+         * @return Value 
+         */
+        Value callValue(Token* paren, Value callee, Value* receiver, ArgumentSpan arguements);
+
+        /**
+         * @brief Leaves a call in tail position for the running function's
+         * callFunction, instead of nesting it. Only Lox functions and
+         * methods are, anything else is called by callValue as usual
+         * 
+         * @param callee 
+         * @param receiver nullptr unless callee is a method
+         * @param arguements 
+         * @return bool false if the callee has to be called by callValue
+         */
+        bool scheduleTailCall(Value callee, Value* receiver, ArgumentSpan arguements);
+
+        // Completion of a return statement, after its value was evaluated
+        Stmt::Completion returnCompletion();
 
     private:
         // Error Handling based on semantics
-        void checkNumberOperand(Token* operator_, std::string* operand);
-        void checkNumberOperands(Token* operator_, std::string* left, std::string* right);
+        void checkNumberOperand(Token* operator_, Value operand);
+        void checkNumberOperands(Token* operator_, Value left, Value right);
 
     private:
-        // Conversion methods from string to other datatypes
-        // Converting String to double
-        double string_to_double(std::string* literal);
-        bool isDouble(std::string* literal);
-        bool isEqual(std::string* a, std::string* b);
+        bool isEqual(Value a, Value b);
 
     private:
         // Utilities
-        std::string stringify(std::string* object);
+        std::string stringify(Value object);
+
+        // Reports the error and abandons every scope in progress
+        void recover(RuntimeError* error);
 
     public:
         // Evaluates the expression and displays in proper format
-        void interpret(std::vector<Stmt::Stmt*>* statements);
+        void interpret(NodeList<Stmt::Stmt*>* statements);
+        // Runs a program compiled by the ClosureCompiler
+        void interpret(CompiledBlock* program);
         void setupNativeFunctions();
-        void resolve(Expr::Expr* expr, int depth);
+
+        // Globals, the live part of the stack and the running closures
+        virtual void markRoots(Heap* heap) override;
 
     
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "./LoxCallable.h"
+#include "./Value.h"
+
+/**
+ * @brief Method read off an instance without calling it, eg: var f = a.method;
+ * Remembers the instance so 'this' is bound when it is called later.
+ * Direct calls like a.method() never create one
+ *
+ */
+class LoxBoundMethod: public LoxCallable
+{
+    public:
+        Value receiver;
+
+        // LoxFunction for the interpreter, VmClosure for the VM
+        // The VM calls the closure itself instead of going through call()
+        LoxObject* method;
+
+    public:
+        LoxBoundMethod(Value receiver, LoxObject* method);
+
+    public:
+        virtual unsigned int arity() override;
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguments) override;
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
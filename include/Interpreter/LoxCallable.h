@@ -3,12 +3,21 @@
 #include <vector>
 #include <string>
 
+#include "./LoxObject.h"
+#include "./Value.h"
+#include "./ArgumentSpan.h"
+
 class Interpreter;
 
-class LoxCallable
+class LoxCallable: public LoxObject
 {
     public:
-        LoxCallable();
+        // Deepest nesting of Lox calls, the same on every backend and with
+        // or without the JIT, deeper calls are the runtime error "Stack overflow."
+        static const int MAX_CALL_DEPTH = 5000;
+
+    public:
+        LoxCallable(ObjectType type);
         virtual unsigned int arity();
-        virtual std::string* call(Interpreter* interpreter, std::vector<std::string*>* arguments);
-};
\ No newline at end of file
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguments);
+};
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "./LoxCallable.h"
 #include "./LoxInstance.h"
+#include "./Shape.h"
 
 /**
  * @brief Runtime Representation of Class in Lox
@@ -13,10 +16,49 @@
 class LoxClass: public LoxCallable
 {
     public:
-        std::string* name;
+        std::string name;
+
+        // Shape of new instances, other shapes are reached by adding fields
+        Shape* rootShape;
+
+        // Methods bound when the class is defined, by interned name
+        // LoxFunctions for the interpreter, VmClosures for the VM
+        std::unordered_map<LoxString*, LoxObject*>* methods;
+
+    private:
+        // Every shape created for instances of this class
+        // They live as long as the class since instances keep it alive
+        std::vector<Shape*>* shapes;
+
+    public:
+        LoxClass(std::string name);
+        virtual ~LoxClass();
 
     public:
-        LoxClass(std::string* name);
+        /**
+         * @brief Looks up a method declared in the class body
+         * 
+         * @param name interned
+         * @return LoxObject* nullptr if the class has no such method
+         */
+        LoxObject* findMethod(LoxString* name);
+
+        /**
+         * @brief Interned "init", the name of initializers
+         * 
+         * @return LoxString* 
+         */
+        static LoxString* initializerName();
+
+        /**
+         * @brief Shape after adding a field to an instance of shape from,
+         * recording a new transition the first time a field is added
+         * 
+         * @param from 
+         * @param name 
+         * @return Shape* 
+         */
+        Shape* transition(Shape* from, LoxString* name);
 
     public:
         /**
@@ -25,5 +67,8 @@ class LoxClass: public LoxCallable
          * @return unsigned int 
          */
         virtual unsigned int arity() override;
-        virtual std::string* call(Interpreter* interpreter, std::vector<std::string*>* arguments) override;
-};
\ No newline at end of file
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguments) override;
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <vector>
+
 #include "./LoxCallable.h"
-#include "./Return.h"
+#include "./LoxUpvalue.h"
 #include "./../Parser/Stmt/StmtHeaders.h"
+#include "./../Closure/CompiledBlock.h"
+
+class JitFunction;
 
 /**
  * @brief Runtime representation of Compiled time syntax node of Function
@@ -12,13 +17,41 @@ class LoxFunction: public LoxCallable
 {
     public:
         Stmt::Function* declaration;
-        Environment* closure;
+
+        // Cells of the captured variables, in the order of declaration->upvalues
+        std::vector<LoxUpvalue*> upvalues;
+
+        // init method of a class, always returns its receiver
+        bool isInitializer;
+
+        // Body compiled by the ClosureCompiler, nullptr when the tree is walked
+        CompiledBlock* compiled;
+
+        // Calls counted until the function is hot, then its machine code
+        unsigned int calls;
+        JitFunction* jitted;
 
     public:
-        LoxFunction(Stmt::Function* declaration, Environment* closure);
+        LoxFunction(Stmt::Function* declaration, bool isInitializer);
         virtual unsigned int arity() override;
-        virtual std::string* call(Interpreter* interpreter, std::vector<std::string*>* arguments) override;
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguments) override;
+
+        /**
+         * @brief Calls the function as a method, the receiver is
+         * stored in slot 0 where the resolver placed 'this'
+         * 
+         * @param interpreter 
+         * @param receiver 
+         * @param arguments 
+         * @return Value 
+         */
+        Value callWithReceiver(Interpreter* interpreter, Value receiver, ArgumentSpan arguments);
 
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+
+    public:
         friend std::ostream& operator<<(std::ostream& os, const LoxFunction& t);
 
 };
\ No newline at end of file
@@ -2,25 +2,63 @@
 
 #include <iostream>
 #include <string>
-#include <unordered_map>
 
 #include "./../Scanner/Token.h"
 #include "./RuntimeError.h"
+#include "./LoxObject.h"
+#include "./LoxString.h"
+#include "./Shape.h"
+#include "./Value.h"
 
 class LoxClass;
 
-class LoxInstance
+/**
+ * @brief Instance of a Lox class.
+ * Field names are kept by the shared Shape, the instance only stores
+ * values at the offsets the shape assigned to them
+ *
+ */
+class LoxInstance: public LoxObject
 {
     public:
-        LoxClass* klass;
+        // Fields stored inside the instance itself, most objects have few
+        static const int INLINE_FIELDS = 4;
 
     public:
-        std::unordered_map<std::string, void*>* fields;
+        LoxClass* klass;
+        Shape* shape;
+
+    private:
+        Value inlineFields[INLINE_FIELDS];
+
+        // Fields past the inline ones
+        Value* extraFields;
+        int extraCapacity;
 
     public:
         LoxInstance(LoxClass* klass);
+        virtual ~LoxInstance();
 
     public:
-        void* get(Token* name);
-        void set(Token* name, void* value);
-};
\ No newline at end of file
+        /**
+         * @brief Reads a field, methods are looked up by the caller
+         * when the instance has no field of that name
+         * 
+         * @param name interned
+         * @param value set to the field value when found
+         * @return bool whether the instance has the field
+         */
+        bool getField(LoxString* name, Value* value);
+
+        void setField(LoxString* name, Value value);
+
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+
+    private:
+        Value& field(int offset);
+
+        // Moves the instance to the shape having one more field
+        void addField(Shape* next, Value value);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+#include "./HeapObject.h"
+
+/**
+ * @brief Kind of heap object a Value of type VAL_OBJECT points to.
+ * Prefixed since unscoped enums share the global namespace with TokenType
+ */
+enum ObjectType
+{
+    OBJ_STRING,
+    OBJ_FUNCTION,
+    OBJ_NATIVE,
+    OBJ_CLASS,
+    OBJ_INSTANCE,
+    OBJ_BOUND_METHOD,
+    // Cell of a local captured by closures, never seen by Lox code
+    OBJ_UPVALUE,
+
+    // Objects only created by the bytecode VM
+    OBJ_VM_FUNCTION,
+    OBJ_VM_CLOSURE,
+    OBJ_VM_UPVALUE
+};
+
+/**
+ * @brief Base class of every runtime entity that cannot be stored
+ * inline inside a Value, such as strings, callables and instances
+ *
+ */
+class LoxObject: public HeapObject
+{
+    public:
+        ObjectType type;
+
+    public:
+        LoxObject(ObjectType type);
+        virtual ~LoxObject();
+
+    public:
+        /**
+         * @brief Text used when the object is printed or concatenated
+         *
+         * @return std::string
+         */
+        virtual std::string toString() = 0;
+};
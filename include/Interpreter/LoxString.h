@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+
+#include "./LoxObject.h"
+
+/**
+ * @brief Runtime representation of Lox string values.
+ * Concatenations of long strings are ropes: the result only points to its
+ * two halves, and their text is copied into it the first time it is read.
+ * So a loop appending to a string copies it once instead of every iteration
+ *
+ */
+class LoxString: public LoxObject
+{
+    public:
+        // Shorter concatenations are copied right away, a rope node
+        // and its later flattening would cost more than the copy
+        static const std::size_t ROPE_MIN_LENGTH = 128;
+
+    public:
+        // Set for strings of the StringTable, only one of which has a given text
+        // Strings built at runtime, eg: by concatenation, are not interned but
+        // find their interned twin through canonical()
+        bool interned;
+        // Hash of value, computed on creation for interned strings and by
+        // canonical() for the others
+        std::size_t hash;
+
+    private:
+        // Interned string with the same text, looked up once by canonical()
+        LoxString* canonical_;
+        bool lookedUp;
+
+        // Complete only once left and right are flattened into it
+        std::string value;
+        std::size_t length_;
+
+        // Halves of a concatenation not copied yet, nullptr for flat strings
+        LoxString* left;
+        LoxString* right;
+
+    public:
+        LoxString(std::string value);
+        // Rope of left followed by right
+        LoxString(LoxString* left, LoxString* right);
+
+    public:
+        /**
+         * @brief Text of the string, a rope is flattened by the first call
+         * and drops its halves
+         *
+         * @return const std::string&
+         */
+        const std::string& text();
+        std::size_t length() const;
+
+        /**
+         * @brief Interned string with the same text. A runtime string looks
+         * itself up in the StringTable the first time, later calls return
+         * the result right away. Looking up never adds to the table, so
+         * nullptr only means no such string was interned at that time
+         *
+         * @return LoxString* itself for interned strings
+         */
+        LoxString* canonical();
+
+        /**
+         * @brief Tracked concatenation of two strings, a rope unless it is short
+         * Both strings have to be reachable by the collector while it runs
+         *
+         * @param heap
+         * @param left
+         * @param right
+         * @return LoxString*
+         */
+        static LoxString* concatenate(Heap* heap, LoxString* left, LoxString* right);
+
+        /**
+         * @brief Same as above when the right half is not a string yet
+         *
+         * @param heap
+         * @param left
+         * @param right
+         * @return LoxString*
+         */
+        static LoxString* concatenate(Heap* heap, LoxString* left, const std::string& right);
+
+    public:
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+
+    private:
+        void flatten();
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include "./LoxObject.h"
+#include "./Value.h"
+
+/**
+ * @brief Cell holding a local variable captured by closures.
+ * The declaring frame and every closure capturing the variable
+ * share the cell, so they all see assignments made by the others
+ *
+ */
+class LoxUpvalue: public LoxObject
+{
+    public:
+        Value value;
+
+    public:
+        LoxUpvalue(Value value);
+
+    public:
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Converts numbers to the text print and concatenation show.
+ * Digits are the shortest that read back as the same double, found with
+ * Grisu2 instead of printf, so formatting never depends on the locale.
+ * Integers print without a fraction, eg: 3 and 2.5, and exponents are
+ * only used outside 1e-7 to 1e21, like JavaScript does
+ *
+ */
+class NumberFormatter
+{
+    public:
+        // Longest output, eg: -2.2250738585072014e-308
+        static const std::size_t MAX_LENGTH = 32;
+
+    public:
+        static std::string format(double number);
+
+        /**
+         * @brief Writes the text of number without allocating
+         *
+         * @param number
+         * @param buffer at least MAX_LENGTH chars, not null terminated
+         * @return std::size_t length of the text
+         */
+        static std::size_t format(double number, char* buffer);
+
+    private:
+        // Integral numbers below 2^53 skip Grisu entirely
+        static std::size_t formatInteger(std::uint64_t integer, char* buffer);
+
+        /**
+         * @brief Shortest digits of a positive finite number
+         *
+         * @param number
+         * @param digits set to the decimal digits, at most 17
+         * @param exponent set so that number is digits * 10^exponent
+         * @return int count of digits
+         */
+        static int grisu2(double number, char* digits, int* exponent);
+
+        // Places the decimal point, or an exponent, in the digits
+        static std::size_t prettify(char* buffer, int length, int exponent);
+};
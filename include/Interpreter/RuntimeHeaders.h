@@ -1,9 +1,17 @@
 #pragma once
 
+#include "./Value.h"
+#include "./LoxObject.h"
+#include "./LoxString.h"
+#include "./StringTable.h"
+#include "./NumberFormatter.h"
+#include "./HeapObject.h"
+#include "./Heap.h"
 #include "./RuntimeError.h"
 #include "./Environment.h"
 #include "./LoxCallable.h"
+#include "./LoxUpvalue.h"
 #include "./LoxFunction.h"
+#include "./LoxBoundMethod.h"
 #include "./LoxClass.h"
 #include "./LoxInstance.h"
-#include "./Return.h"
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./LoxString.h"
+
+/**
+ * @brief Hidden class describing the field layout of instances.
+ * Instances that got the same fields in the same order share a shape,
+ * so names are stored once per shape instead of once per instance.
+ * Each shape adds one field to its parent, which gets the next offset.
+ * Shapes along one chain share a table of offsets, so finding a field
+ * takes constant time on any shape, only a branch copies its parent's part.
+ * Adding a field scans the transitions of a shape, which are usually one
+ *
+ */
+class Shape
+{
+    public:
+        // Small shapes are walked up to the root instead of hashing the name
+        static const int LINEAR_SEARCH_MAX = 8;
+
+        // Unique for the whole session, unlike the address of a shape
+        // which can be reused once its class is collected
+        unsigned long id;
+
+        Shape* parent;
+
+        // Interned name of the field added by this shape, nullptr for the root shape
+        LoxString* name;
+
+        // Number of fields of instances having this shape
+        int fieldCount;
+
+        // Shapes reached by adding one more field
+        // Usually one, hence scanned instead of hashed
+        std::vector<Shape*> transitions;
+
+    private:
+        static unsigned long nextId;
+
+        // Offsets of every field added along this chain of shapes, the ones
+        // below fieldCount are the fields of this shape
+        std::shared_ptr<std::unordered_map<LoxString*, int>> offsets;
+
+    public:
+        // Root shape, without fields
+        Shape();
+        Shape(Shape* parent, LoxString* name);
+
+    public:
+        /**
+         * @brief Offset of a field in instances of this shape
+         *
+         * @param name interned
+         * @return int -1 if the shape has no such field
+         */
+        int find(LoxString* name);
+
+        /**
+         * @brief Existing transition adding the field
+         *
+         * @param name interned
+         * @return Shape* nullptr if no instance added it yet
+         */
+        Shape* next(LoxString* name);
+};
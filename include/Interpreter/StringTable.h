@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "./LoxString.h"
+
+/**
+ * @brief Intern table giving every distinct text one LoxString for the
+ * whole session. Identifiers and string literals are interned by the
+ * scanner, so names can be compared and hashed by address afterwards.
+ * Interned strings are never tracked by a Heap, hence never collected
+ *
+ */
+class StringTable
+{
+    private:
+        // Open addressing with linear probing, the capacity is a power of 2
+        std::vector<LoxString*> entries;
+        std::size_t count;
+
+    public:
+        StringTable();
+
+        // Table shared by the scanner and every backend
+        // Created on first use, since static objects of other files need it
+        static StringTable* global();
+
+    public:
+        /**
+         * @brief The interned string with this text, created on first request
+         *
+         * @param chars
+         * @param length
+         * @return LoxString*
+         */
+        LoxString* intern(const char* chars, std::size_t length);
+        LoxString* intern(const std::string& text);
+
+        /**
+         * @brief The interned string with this text if there is one, nothing
+         * is added. Runtime strings are looked up this way, so the table
+         * never grows with text built while a script runs
+         *
+         * @param chars
+         * @param length
+         * @param hash of chars
+         * @return LoxString* nullptr if the text is not interned
+         */
+        LoxString* find(const char* chars, std::size_t length, std::size_t hash);
+
+        // FNV-1a, computed once per interned string
+        static std::size_t hash(const char* chars, std::size_t length);
+
+    private:
+        void grow();
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <string>
+
+#include "./LoxObject.h"
+
+class LoxString;
+class LoxCallable;
+class LoxClass;
+class LoxInstance;
+
+enum ValueType
+{
+    VAL_NIL,
+    VAL_BOOL,
+    VAL_NUMBER,
+    VAL_OBJECT
+};
+
+/**
+ * @brief Runtime representation of every Lox value.
+ * nil, booleans and numbers are stored inline so arithmetic and comparisons
+ * never allocate, everything else points to a heap LoxObject.
+ *
+ * Checks and accessors used on every evaluation are defined inline
+ */
+class Value
+{
+    public:
+        ValueType type;
+
+        union {
+            bool boolean;
+            double number;
+            LoxObject* object;
+        } as;
+
+    public:
+        // Default constructed Value is nil
+        Value() : type(VAL_NIL) { as.number = 0; }
+
+        static Value fromBool(bool boolean)
+        {
+            Value value;
+            value.type = VAL_BOOL;
+            value.as.boolean = boolean;
+            return value;
+        }
+
+        static Value fromNumber(double number)
+        {
+            Value value;
+            value.type = VAL_NUMBER;
+            value.as.number = number;
+            return value;
+        }
+
+        static Value fromObject(LoxObject* object)
+        {
+            Value value;
+            value.type = VAL_OBJECT;
+            value.as.object = object;
+            return value;
+        }
+
+    public:
+        bool isNil() const { return type == VAL_NIL; }
+        bool isBool() const { return type == VAL_BOOL; }
+        bool isNumber() const { return type == VAL_NUMBER; }
+        bool isObject() const { return type == VAL_OBJECT; }
+
+        bool isObjectType(ObjectType objectType) const
+        {
+            return type == VAL_OBJECT && as.object->type == objectType;
+        }
+
+        bool isString() const { return isObjectType(OBJ_STRING); }
+        bool isInstance() const { return isObjectType(OBJ_INSTANCE); }
+        bool isCallable() const
+        {
+            return  isObjectType(OBJ_FUNCTION) ||
+                    isObjectType(OBJ_NATIVE) ||
+                    isObjectType(OBJ_CLASS) ||
+                    isObjectType(OBJ_BOUND_METHOD);
+        }
+
+        bool asBool() const { return as.boolean; }
+        double asNumber() const { return as.number; }
+        LoxObject* asObject() const { return as.object; }
+
+        LoxString* asString() const;
+        LoxCallable* asCallable() const;
+        LoxInstance* asInstance() const;
+
+    public:
+        /**
+         * @brief Lox equality, strings are compared by content
+         * and every other object by identity
+         */
+        bool equals(Value other) const;
+
+        std::string toString() const;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "./../Scanner/TokenType.h"
+
+/**
+ * @brief Emits the fixed x86-64 instruction templates the JitCompiler
+ * builds functions from. Numbers are computed in xmm0 with xmm1 as the
+ * right operand, booleans in eax as 0 or 1. Every local and temporary
+ * lives in a stack slot of the frame addressed from rbp, and rbx holds
+ * the JitContext for the whole call
+ *
+ */
+class Assembler
+{
+    public:
+        std::vector<uint8_t> code;
+
+    public:
+        /**
+         * @brief Frame setup, the frame size is patched once every
+         * slot of the function is known
+         *
+         * @return int offset to pass to patchFrameSize()
+         */
+        int prologue();
+        void patchFrameSize(int offset, int slotCount);
+        void epilogue();
+
+    public:
+        // Copies the arguement at index of the array in rdi into a slot
+        void loadArgument(int index, int slot);
+        void loadSlot(int slot);
+        void storeSlot(int slot);
+        // Moves the right operand to xmm1 and the left one from its slot to xmm0
+        void loadLeftOperand(int slot);
+        void loadNumber(double number);
+        void loadBool(bool boolean);
+
+    public:
+        // xmm0 = xmm0 operator xmm1, for + - * /
+        void arithmetic(TokenType operator_);
+        // eax = xmm0 operator xmm1, for comparisons and equality
+        void compare(TokenType operator_);
+        void negate();
+        void not_();
+
+    public:
+        // Jumps emitted with a placeholder target return its offset for patchJump()
+        int jump();
+        int jumpIfFalse();
+        int jumpIfTrue();
+        // Jumps when the JitContext has its bailout flag set
+        int jumpIfBailout();
+        void patchJump(int offset);
+        void jumpBack(int target);
+        void setBailout();
+
+        /**
+         * @brief Calls helper(context, site, arguements) where the
+         * arguements are consecutive slots, ending with the first one
+         *
+         * @param helper
+         * @param site
+         * @param firstArgumentSlot
+         */
+        void callHelper(void* helper, void* site, int firstArgumentSlot);
+
+    public:
+        int size();
+
+    private:
+        void emit(uint8_t byte);
+        void emit32(int32_t value);
+        void emit64(uint64_t value);
+        // movsd between xmm register and a frame slot
+        void slotInstruction(uint8_t opcode, int xmm, int slot);
+        static int32_t slotOffset(int slot);
+};
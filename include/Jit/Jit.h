@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "./../Parser/Stmt/StmtHeaders.h"
+#include "./../Interpreter/Value.h"
+#include "./../Interpreter/ArgumentSpan.h"
+
+// Machine code is only emitted on x86-64 Linux, elsewhere every function is interpreted
+#if defined(__x86_64__) && defined(__linux__)
+#define LOX_JIT_SUPPORTED 1
+#endif
+
+class Jit;
+class JitFunction;
+class Environment;
+
+/**
+ * @brief State shared by the compiled functions of one call from the
+ * interpreter. The bailout flag has to stay first, compiled code tests it
+ * through the context pointer after every call
+ */
+struct JitContext
+{
+    int32_t bailout;
+    int32_t depth;
+    Jit* jit;
+};
+
+/**
+ * @brief Call of a global function from compiled code. The callee is
+ * looked up on every call, its code is cached per declaration since it
+ * does not depend on the closure
+ */
+struct JitCallSite
+{
+    int globalSlot;
+    unsigned int argCount;
+
+    Stmt::Function* declaration;
+    JitFunction* function;
+};
+
+// Compiled function, taking its arguements as an array of numbers
+typedef double (*JitEntry)(double* arguments, JitContext* context);
+
+/**
+ * @brief Machine code of a function declaration
+ */
+class JitFunction
+{
+    public:
+        // nullptr when the body uses anything the JitCompiler cannot compile
+        JitEntry entry;
+
+        // Executable pages holding the code
+        void* memory;
+        std::size_t size;
+
+        std::vector<JitCallSite*> callSites;
+
+        // Runs abandoned to the interpreter, the function is no longer
+        // compiled code once they reach MAX_BAILOUTS
+        int bailouts;
+
+    public:
+        JitFunction();
+};
+
+/**
+ * @brief Baseline template JIT for hot functions of the tree walking
+ * Interpreter. LoxFunction counts its calls and once HOT_CALLS is reached
+ * its declaration is compiled to x86-64 if the body only does number
+ * arithmetic and comparisons on parameters and locals, and calls global
+ * functions that compile as well.
+ * Such code has no side effects, so whenever compiled code meets anything
+ * it cannot handle it bails out and the interpreter runs the call again
+ *
+ */
+class Jit
+{
+    public:
+        static const unsigned int HOT_CALLS = 100;
+        static const int MAX_BAILOUTS = 10;
+
+    public:
+        // Cleared by --no-jit
+        bool enabled;
+
+        // Callees are read from the interpreter's globals
+        Environment* globals;
+
+    private:
+        // Code of every declaration compiled so far, including failed ones
+        std::unordered_map<Stmt::Function*, JitFunction*>* functions;
+
+    public:
+        Jit(Environment* globals);
+
+    public:
+        /**
+         * @brief Machine code of the declaration, compiled on first request
+         *
+         * @param declaration
+         * @return JitFunction* never nullptr, its entry is when unsupported
+         */
+        JitFunction* compile(Stmt::Function* declaration);
+
+        /**
+         * @brief Runs compiled code with the arguements of an interpreter call
+         *
+         * @param function
+         * @param arguments
+         * @param depth calls the interpreter already has in progress
+         * @param result set to the returned number
+         * @return bool false if the interpreter has to run the call instead
+         */
+        bool run(JitFunction* function, ArgumentSpan arguments, int depth, Value* result);
+
+        /**
+         * @brief Called from compiled code for every call site.
+         * Never throws since there is no unwind information for compiled frames,
+         * errors set the bailout flag of the context instead
+         *
+         * @param context
+         * @param site
+         * @param arguments
+         * @return double
+         */
+        static double call(JitContext* context, JitCallSite* site, double* arguments);
+
+    private:
+        // Copies the code into executable pages
+        void install(JitFunction* function, const std::vector<uint8_t>& code);
+};
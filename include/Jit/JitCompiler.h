@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "./../Parser/Expression/ExpressionHeaders.h"
+#include "./../Parser/Stmt/StmtHeaders.h"
+#include "./Assembler.h"
+#include "./Jit.h"
+
+/**
+ * @brief Static type of a compiled expression, parameters and locals are
+ * always numbers while comparisons and boolean literals produce booleans
+ */
+enum JitType
+{
+    JIT_NUMBER,
+    JIT_BOOL,
+};
+
+/**
+ * @brief Compiles a resolved function declaration into x86-64, one
+ * template per node. Compilation gives up on the first node outside the
+ * supported subset: only parameters and locals of the function itself,
+ * number and boolean literals, arithmetic, comparisons, logical operators,
+ * if, while, return of numbers and calls of global functions
+ *
+ */
+class JitCompiler:
+    public Expr::Visitor<std::string*>,
+    public Stmt::Visitor<void*>
+{
+    private:
+        Jit* jit;
+        JitFunction* function;
+        Assembler assembler;
+
+        // Locals use the frame slots numbered by the resolver,
+        // temporaries and arguements come after the most locals alive at once
+        int localCount;
+        int slotCount;
+        std::vector<int> freeTemporaries;
+
+        // Jumps to the epilogue, from returns and bailouts
+        std::vector<int> exits;
+
+        // Type of the last compiled expression
+        JitType type;
+        bool supported;
+
+    public:
+        JitCompiler(Jit* jit);
+
+        /**
+         * @brief Compiles the body of a declaration
+         *
+         * @param declaration
+         * @param function receives the call sites of the code
+         * @param code set to the machine code
+         * @return bool false if the body uses anything unsupported
+         */
+        bool compile(Stmt::Function* declaration, JitFunction* function, std::vector<uint8_t>* code);
+
+    public:
+        virtual std::string* visitAssignExpr(Expr::Assign* expr) override;
+        virtual std::string* visitBinaryExpr(Expr::Binary* expr) override;
+        virtual std::string* visitCallExpr(Expr::Call* expr) override;
+        virtual std::string* visitGetExpr(Expr::Get* expr) override;
+        virtual std::string* visitGroupingExpr(Expr::Grouping* expr) override;
+        virtual std::string* visitLiteralExpr(Expr::Literal* expr) override;
+        virtual std::string* visitLogicalExpr(Expr::Logical* expr) override;
+        virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
+        virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
+        virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual std::string* visitThisExpr(Expr::This* expr) override;
+
+    public:
+        virtual void* visitBlockStmt(Stmt::Block* stmt) override;
+        virtual void* visitClassStmt(Stmt::Class* stmt) override;
+        virtual void* visitExpressionStmt(Stmt::Expression* stmt) override;
+        virtual void* visitFunctionStmt(Stmt::Function* stmt) override;
+        virtual void* visitIfStmt(Stmt::If* stmt) override;
+        virtual void* visitPrintStmt(Stmt::Print* stmt) override;
+        virtual void* visitReturnStmt(Stmt::Return* stmt) override;
+        virtual void* visitVarStmt(Stmt::Var* stmt) override;
+        virtual void* visitWhileStmt(Stmt::While* stmt) override;
+
+    private:
+        void compile(Stmt::Stmt* stmt);
+        void compile(Expr::Expr* expr);
+        void compileNumber(Expr::Expr* expr);
+
+        // Jump taken when the condition is false, -1 for numbers since they are always truthy
+        int compileCondition(Expr::Expr* condition);
+        void unsupported();
+
+    private:
+        // Frame slot handling
+        int declareLocal();
+        // Frame slot of a variable resolved in this function, -1 otherwise
+        int resolveLocal(Expr::VariableKind kind, int slot);
+        int allocateTemporary();
+        void releaseTemporary(int slot);
+};
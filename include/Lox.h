@@ -1,6 +1,8 @@
 #pragma once
 
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -10,13 +12,42 @@
 #include "./Parser/Parser.h"
 #include "./Parser/AstPrinter.h"
 #include "./Semantic/Resolver.h"
+#include "./Semantic/Optimizer.h"
 #include "./Interpreter/Interpreter.h"
 #include "./Interpreter/RuntimeError.h"
+#include "./VM/VM.h"
+#include "./Closure/ClosureCompiler.h"
+#include "./Jit/Jit.h"
+#include "./Output/Output.h"
 
 class Interpreter; 
+class VM;
+class Arena;
+class ClosureCompiler;
+class Optimizer;
+
+/**
+ * @brief Source, tokens and syntax tree of one program, which point into
+ * each other. Kept for the rest of the session once the program declared
+ * functions or classes, whose runtime objects refer to their declarations
+ *
+ */
+struct LoadedProgram
+{
+    std::unique_ptr<const Source> source;
+    std::unique_ptr<std::vector<Token>> tokens;
+    std::unique_ptr<Arena> arena;
+};
 
 class Lox
 {
+    public:
+        // Native stack of the thread running the session. Tree walking calls
+        // took up to 6 KB of it each in a -O0 build, deeply nested bodies
+        // included, so LoxCallable::MAX_CALL_DEPTH of them fit with room to spare.
+        // Only the pages actually used are ever committed
+        static const std::size_t STACK_SIZE = 256 * 1024 * 1024;
+
     public:
         /**
          * @brief Static because the entire session of REPL or 
@@ -26,10 +57,37 @@ class Lox
          */
         static Interpreter* interpreter;
 
+        // Bytecode VM, set by --vm to run programs on it instead
+        static VM* vm;
+
+        // Set by --closures to run programs compiled into closures
+        static ClosureCompiler* closureCompiler;
+
+        // Folds constants of every program before it runs, on any backend
+        static Optimizer* optimizer;
+
+        // Where print statements of every backend write, stdout by default
+        static Output* output;
+
+        // Programs of this session that declared functions or classes
+        // Every other program is freed as soon as it ran
+        static std::vector<LoadedProgram>* programs;
+
+        // Set by --timings to report where the time of a session went at exit
+        static bool reportTimings;
+
     public:
         static bool hadError;
         static bool hadRuntimeError;
 
+    private:
+        // Milliseconds spent reading the script, in the passes before it runs
+        // and running it
+        static double loadMs;
+        static double compileMs;
+        static double runMs;
+        static bool sourceMapped;
+
     private:
         static void report(int line, std::string where, std::string message);
 
@@ -37,12 +95,20 @@ class Lox
         // Reports an Error for a given Token
         static void error(Token* token, std::string message);
         static void runtimeError(RuntimeError error);
+        static void runtimeError(int line, std::string message);
         
         // Reports an Error for a given Character 
         static void error(int line, std::string message);
-        static void run(std::string* srcCode);
+        // Takes the source, kept only while functions it declared may still run
+        static void run(std::unique_ptr<const Source> source);
         static void runFile(char* filepath);
         static void runPrompt();
 
+        // Runs the script, or the REPL without one, on a thread with STACK_SIZE of stack
+        static void runSession(char* script);
+
+        // Prints statistics requested by command line options
+        static void reportStats();
+
 };
 
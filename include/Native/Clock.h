@@ -7,9 +7,14 @@
 
 class Clock: public LoxCallable
 {
+    public:
+        Clock();
+
     public:
         virtual unsigned int arity() override;
-        virtual std::string* call(Interpreter* interpreter, std::vector<std::string*>* arguements) override;
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguements) override;
+        virtual std::string toString() override;
+        virtual std::size_t size() override;
 
         friend std::ostream& operator<<(std::ostream& os, const Clock& t);
 };
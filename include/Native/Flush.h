@@ -0,0 +1,19 @@
+#pragma once
+
+#include "./../Interpreter/LoxCallable.h"
+
+/**
+ * @brief flush(), writes out everything printed so far
+ * Output is buffered, eg: a script reporting progress calls it after each step
+ */
+class Flush: public LoxCallable
+{
+    public:
+        Flush();
+
+    public:
+        virtual unsigned int arity() override;
+        virtual Value call(Interpreter* interpreter, ArgumentSpan arguements) override;
+        virtual std::string toString() override;
+        virtual std::size_t size() override;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "./OutputTarget.h"
+#include "./../Interpreter/Value.h"
+
+/**
+ * @brief Buffered output of print statements, shared by every backend.
+ * Text is collected in a large buffer and written to the target once it
+ * fills, so printing a line is a copy instead of a system call.
+ * Output has to be flushed before anything is written to stderr,
+ * to keep the order of both streams. It owns its target
+ *
+ */
+class Output
+{
+    public:
+        static const std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    private:
+        OutputTarget* target;
+        std::size_t capacity;
+        std::string buffer;
+
+        // Writer thread, set by startWriter()
+        // Full buffers are handed to it, and it writes them in order
+        std::thread* writer;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::string pending;
+        bool hasPending;
+        bool writing;
+        bool stopping;
+
+    public:
+        Output(OutputTarget* target, std::size_t capacity = DEFAULT_CAPACITY);
+
+    public:
+        // Moves writes to the target off the calling thread
+        void startWriter();
+
+        /**
+         * @brief Replaces the target, flushing what the previous one was given
+         * before deleting it
+         *
+         * @param target
+         */
+        void setTarget(OutputTarget* target);
+
+        // Text of a value followed by a newline, as print shows it
+        void print(Value value);
+        void write(const char* data, std::size_t length);
+
+        // Returns once everything written so far reached the target
+        void flush();
+
+        // Flushes and stops the writer, output can still be written after it
+        void close();
+
+    private:
+        // Passes the buffer to the target or to the writer
+        void drain();
+        void runWriter();
+};
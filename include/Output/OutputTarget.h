@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Destination of the text buffered by Output.
+ * Writes always come in whole buffers, and never from two threads at once
+ *
+ */
+class OutputTarget
+{
+    public:
+        virtual ~OutputTarget();
+
+    public:
+        virtual void write(const char* data, std::size_t length) = 0;
+};
+
+/**
+ * @brief Writes straight to a file descriptor, stdout unless a file is opened.
+ * Bypasses iostreams, whose own buffering would only add a copy
+ *
+ */
+class FileTarget: public OutputTarget
+{
+    private:
+        int fd;
+        bool ownsFd;
+
+    public:
+        // Standard output
+        FileTarget();
+
+        /**
+         * @brief Truncates or creates the file
+         *
+         * @param path
+         * @param error set to a message if the file cant be opened
+         */
+        FileTarget(const std::string& path, std::string* error);
+        virtual ~FileTarget();
+
+    public:
+        virtual void write(const char* data, std::size_t length) override;
+};
+
+/**
+ * @brief Keeps everything written, for embedders and tests comparing output
+ *
+ */
+class MemoryTarget: public OutputTarget
+{
+    public:
+        std::string contents;
+
+    public:
+        virtual void write(const char* data, std::size_t length) override;
+};
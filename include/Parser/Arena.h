@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./NodeList.h"
+
+/**
+ * @brief Bump pointer allocator owning the syntax tree of one parse.
+ * Nodes and their child lists are carved out of large blocks, so they
+ * sit next to each other in memory and are all freed at once with the arena.
+ * Destructors are never run, hence only trivially destructible types are allowed
+ *
+ */
+class Arena
+{
+    public:
+        static const std::size_t BLOCK_SIZE = 64 * 1024;
+
+    private:
+        std::vector<char*>* blocks;
+
+        // Free space left in the last block
+        char* current;
+        std::size_t remaining;
+
+    public:
+        Arena();
+        ~Arena();
+
+    public:
+        void* allocate(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Constructs a node inside the arena
+         * 
+         * @return T* 
+         */
+        template <class T, class... Args>
+        T* make(Args&&... args)
+        {
+            static_assert(
+                std::is_trivially_destructible<T>::value,
+                "Arena never runs destructors"
+            );
+
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Copies items collected by the parser into a contiguous list
+         * 
+         * @param items 
+         * @return NodeList<T>* 
+         */
+        template <class T>
+        NodeList<T>* makeList(const std::vector<T>& items)
+        {
+            T* copy = static_cast<T*>(allocate(sizeof(T) * items.size(), alignof(T)));
+
+            for (std::size_t i = 0; i < items.size(); i++) {
+                new (copy + i) T(items[i]);
+            }
+
+            return make<NodeList<T>>(copy, items.size());
+        }
+};
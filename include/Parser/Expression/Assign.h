@@ -10,9 +10,15 @@ namespace Expr {
             Token* name;        
             Expr* value;
 
+            // Location filled by the resolver
+            // slot of a global is cached by the interpreter on first execution
+            VariableKind kind;
+            int slot;
+
         public:
             Assign(Token* name, Expr* value);
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };
 }
\ No newline at end of file
@@ -4,6 +4,34 @@
 #include "./Expr.h"
 
 namespace Expr {
+    /**
+     * @brief Operation a Binary node rewrote itself into, after observing
+     * the operand types of its first evaluation.
+     * Specialized operations guard their operand types and turn the node
+     * GENERIC for good once the guard fails, so a node never flip flops
+     */
+    enum BinarySpecialization
+    {
+        BINARY_UNSPECIALIZED,
+        BINARY_GENERIC,
+
+        BINARY_ADD_NUMBERS,
+        BINARY_SUBTRACT_NUMBERS,
+        BINARY_MULTIPLY_NUMBERS,
+        BINARY_DIVIDE_NUMBERS,
+        BINARY_GREATER_NUMBERS,
+        BINARY_GREATER_EQUAL_NUMBERS,
+        BINARY_LESS_NUMBERS,
+        BINARY_LESS_EQUAL_NUMBERS,
+        BINARY_EQUAL_NUMBERS,
+        BINARY_NOT_EQUAL_NUMBERS,
+
+        BINARY_ADD_STRINGS,
+        // Outermost node of a chain of additions that made a string
+        // Handles any operand types, so it is never made generic
+        BINARY_CONCATENATE
+    };
+
     /**
      * @brief Derived class of Expr. 
      * Will define grammar production rules like this by indiviually mentioning the
@@ -18,10 +46,14 @@ namespace Expr {
             Token* operator_;    // operator is a keyword in Cpp
             Expr* right;
 
+            // Rewritten by the interpreter while the node runs
+            BinarySpecialization specialization;
+
         public:
             Binary(Expr* left, Token* operator_, Expr* right);
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };
 
     // The process of generating Subclasses such as above is Automated
@@ -1,23 +1,54 @@
 #pragma once
 
-#include <vector>
+#include "./../NodeList.h"
 
 #include "./../../Scanner/Token.h"
 #include "./Expr.h"
+#include "./Get.h"
+
+class LoxObject;
 
 namespace Expr
 {
+    // Receiver shapes remembered by a method call site
+    // Sites that saw more shapes than this stop caching (megamorphic)
+    const int METHOD_CACHE_SIZE = 4;
+
+    /**
+     * @brief Method found for instances of one shape.
+     * Shapes are identified by id instead of address, since an address
+     * can be reused once the class owning the shape is collected
+     */
+    struct MethodCacheEntry
+    {
+        unsigned long shapeId;
+        LoxObject* method;
+    };
+
     class Call: public Expr 
     {
         public:
             Expr* callee;
             Token* paren;   // Required for throwing error
-            std::vector<Expr*>* arguments;
+            NodeList<Expr*>* arguments;
+
+            // Set when the callee is a property access, eg: object.method()
+            // Such calls look the method up without creating a bound method
+            Get* method;
+
+            // Inline cache of the method call site
+            MethodCacheEntry methodCache[METHOD_CACHE_SIZE];
+            int methodCacheCount;
+
+            // Set by the resolver when the call is the value of a return,
+            // so it can replace the frame of the returning function
+            bool tailCall;
 
         public:
-            Call(Expr* callee, Token* paren, std::vector<Expr*>* arguments);
+            Call(Expr* callee, Token* paren, NodeList<Expr*>* arguments);
 
             std::string* accept(Visitor<std::string*>* visitor);
+            Value accept(Visitor<Value>* visitor);
 
     };
 }
@@ -2,7 +2,28 @@
 
 #include <string>
 
+#include "./../../Interpreter/Value.h"
+
 namespace Expr {
+    /**
+     * @brief Where the resolver placed a variable, for its uses and declaration.
+     * Locals captured by closures are boxed in a cell that the closures
+     * share through their upvalues, every other local sits in the frame
+     */
+    enum VariableKind
+    {
+        VARIABLE_GLOBAL,
+        // Slot of the running function's frame
+        VARIABLE_LOCAL,
+        // Slot of the running function's frame, holding a LoxUpvalue
+        VARIABLE_CELL,
+        // Index in the upvalues of the running closure
+        VARIABLE_UPVALUE
+    };
+
+    // Slot of a global variable whose table index is not cached yet
+    const int UNCACHED_SLOT = -1;
+
     class Binary;
     class Grouping;
     class Literal;
@@ -13,6 +34,7 @@ namespace Expr {
     class Call;
     class Get;
     class Set;
+    class This;
 
     // "Visitor base class"
     template <class T>
@@ -30,6 +52,7 @@ namespace Expr {
             virtual T visitCallExpr(Call* expr) { return T(); }
             virtual T visitGetExpr(Get* expr) { return T(); }
             virtual T visitSetExpr(Set* expr) { return T(); }
+            virtual T visitThisExpr(This* expr) { return T(); }
     };
 
     /**
@@ -40,5 +63,6 @@ namespace Expr {
     {
         public:
             virtual std::string* accept(Visitor<std::string*>* visitor);
+            virtual Value accept(Visitor<Value>* visitor);
     };
 }
@@ -12,4 +12,5 @@
 #include "./Logical.h"
 #include "./Call.h"
 #include "./Get.h"
-#include "./Set.h"
\ No newline at end of file
+#include "./Set.h"
+#include "./This.h"
\ No newline at end of file
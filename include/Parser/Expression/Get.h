@@ -19,5 +19,6 @@ namespace Expr {
 
         public:
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };
 }
\ No newline at end of file
@@ -13,5 +13,6 @@ namespace Expr {
             Grouping(Expr* expression);   
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };                                     
 }
\ No newline at end of file
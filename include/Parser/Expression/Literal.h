@@ -7,11 +7,12 @@ namespace Expr {
     class Literal : public Expr                       
     {                                      
         public:                            
-            std::string* value;  
+            Value value;  
                                 
         public:                             
-            Literal(std::string* value);   
+            Literal(Value value);   
             
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };                                     
 }
\ No newline at end of file
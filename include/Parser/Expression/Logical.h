@@ -4,6 +4,17 @@
 #include "./Expr.h"
 
 namespace Expr {
+    // Operation a Logical node rewrote itself into, see BinarySpecialization
+    // Boolean left operands are tested without the truthiness rules
+    enum LogicalSpecialization
+    {
+        LOGICAL_UNSPECIALIZED,
+        LOGICAL_GENERIC,
+
+        LOGICAL_AND_BOOL,
+        LOGICAL_OR_BOOL
+    };
+
     class Logical: public Expr 
     {
         public: 
@@ -11,9 +22,13 @@ namespace Expr {
             Token* operator_;
             Expr* right;
 
+            // Rewritten by the interpreter while the node runs
+            LogicalSpecialization specialization;
+
         public:
             Logical(Expr* left, Token* operator_, Expr* right);
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };
 }
\ No newline at end of file
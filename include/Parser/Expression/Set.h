@@ -16,5 +16,6 @@ namespace Expr {
 
         public:
             std::string* accept(Visitor<std::string*>* visitor);
+            Value accept(Visitor<Value>* visitor);
     };
 }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "./../../Scanner/Token.h"
+#include "./Expr.h"
+
+namespace Expr
+{
+    /**
+     * @brief 'this' inside a method, resolved like a local variable
+     * holding the receiver
+     * 
+     */
+    class This : public Expr
+    {
+        public:
+            Token* keyword;
+
+            // Location filled by the resolver
+            VariableKind kind;
+            int slot;
+
+        public:
+            This(Token* keyword);
+
+            virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
+    };
+}
@@ -4,15 +4,29 @@
 #include "./Expr.h"                   
 
 namespace Expr {
+    // Operation a Unary node rewrote itself into, see BinarySpecialization
+    enum UnarySpecialization
+    {
+        UNARY_UNSPECIALIZED,
+        UNARY_GENERIC,
+
+        UNARY_NEGATE_NUMBER,
+        UNARY_NOT_BOOL
+    };
+
     class Unary : public Expr                  
     {                                      
         public:                            
             Token* operator_;  
             Expr* right;  
+
+            // Rewritten by the interpreter while the node runs
+            UnarySpecialization specialization;
                                 
         public:                             
             Unary(Token* operator_, Expr* right);   
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     };     
 }                                
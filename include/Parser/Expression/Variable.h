@@ -9,10 +9,16 @@ namespace Expr
     {                                      
         public:                            
             Token* name;  
+
+            // Location filled by the resolver
+            // slot of a global is cached by the interpreter on first execution
+            VariableKind kind;
+            int slot;
                                 
         public:                             
             Variable(Token* name);   
 
             virtual std::string* accept(Visitor<std::string*>* visitor) override;
+            virtual Value accept(Visitor<Value>* visitor) override;
     }; 
 } 
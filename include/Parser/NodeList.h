@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Fixed size list of child nodes, eg: statements of a block.
+ * Items are stored contiguously in the Arena that owns the syntax tree,
+ * the list is built once by the parser and never grows
+ *
+ */
+template <class T>
+class NodeList
+{
+    public:
+        T* items;
+        std::size_t count;
+
+    public:
+        NodeList(T* items, std::size_t count) : items(items), count(count) {}
+
+    public:
+        T* begin() const { return items; }
+        T* end() const { return items + count; }
+
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        T& at(std::size_t index) const { return items[index]; }
+        T& operator[](std::size_t index) const { return items[index]; }
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdlib>
 #include <vector>
 
 #include "./../Lox.h"
@@ -7,16 +8,20 @@
 #include "./Expression/ExpressionHeaders.h"
 #include "./Stmt/StmtHeaders.h"
 #include "./ParseError.h"
+#include "./Arena.h"
 
 class Parser 
 {
     private:
-        std::vector<Token*>* tokens;
+        std::vector<Token>* tokens;
         int current = 0;
 
+        // Every node and child list of the tree is allocated in it
+        Arena* arena;
+
     public:
-        Parser(std::vector<Token*>* tokens);
-        std::vector<Stmt::Stmt*>* parse();
+        Parser(std::vector<Token>* tokens, Arena* arena);
+        NodeList<Stmt::Stmt*>* parse();
 
     // Expression handling
     private:
@@ -58,12 +63,12 @@ class Parser
         Stmt::Stmt* forStatement();
         Stmt::Stmt* varDeclaration();
         Stmt::Stmt* classDeclaration();
-        std::vector<Stmt::Stmt*>* block();
+        NodeList<Stmt::Stmt*>* block();
         Stmt::Stmt* function(std::string kind);
         Stmt::Stmt* returnStatement();
 
     private:
-        bool match(std::vector<TokenType> tokenTypes);
+        bool match(const std::vector<TokenType>& tokenTypes);
         bool match(TokenType type);
         Token* previous();
         bool check(TokenType type);
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include "./../NodeList.h"
 
 #include "./Stmt.h"
 
@@ -9,12 +9,16 @@ namespace Stmt {
     {
         public:
             // Contains references to all statements inside the block
-            std::vector<Stmt*>* statements;
+            NodeList<Stmt*>* statements;
+
+            // Locals declared directly in the block, set by the resolver.
+            // Blocks without any run without touching the interpreter's stack
+            int localCount;
 
         public:
-            Block();
-            Block(std::vector<Stmt*>* statements);
+            Block(NodeList<Stmt*>* statements);
 
             virtual void* accept(Visitor<void*>* visitor) override;
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include "./../NodeList.h"
 
 #include "./../../Scanner/Token.h"
 #include "./Stmt.h"
@@ -12,11 +12,15 @@ namespace Stmt {
         public:
             // Stores class name and methods inside the body
             Token* name;
-            std::vector<Function*>* methods;
+            NodeList<Function*>* methods;
+
+            // Where the resolver placed the class name
+            Expr::VariableKind kind;
 
         public:
-            Class(Token* name, std::vector<Function*>* methods);
+            Class(Token* name, NodeList<Function*>* methods);
             virtual void* accept(Visitor<void*>* visitor);
+            virtual Completion accept(Visitor<Completion>* visitor);
 
     };
 }
\ No newline at end of file
@@ -2,18 +2,30 @@
 
 #include "./../../Scanner/Scanner.h"
 #include "./Stmt.h"
+#include "./../NodeList.h"
 
 namespace Stmt {
     class Function: public Stmt 
     {
         public:
             Token* name;
-            std::vector<Token*>* params;
-            std::vector<Stmt*>* body;
+            NodeList<Token*>* params;
+            NodeList<Stmt*>* body;
+
+            // Frame layout filled by the resolver
+            // Where the function's name is declared
+            Expr::VariableKind kind;
+            // Captures copied into every closure made from the declaration
+            NodeList<Capture>* upvalues;
+            // Slots of the parameters, or receiver, boxed on entry since closures capture them
+            NodeList<int>* cellParameters;
+            // Most locals alive at once, including parameters
+            int slotCount;
 
         public:
-            Function(Token* name, std::vector<Token*>* params, std::vector<Stmt*>* body);
+            Function(Token* name, NodeList<Token*>* params, NodeList<Stmt*>* body);
             void* accept(Visitor<void*>* visitor);
+            Completion accept(Visitor<Completion>* visitor);
         
     };
 }
\ No newline at end of file
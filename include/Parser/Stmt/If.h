@@ -13,5 +13,6 @@ namespace Stmt {
             If(Expr::Expr* condition, Stmt* thenBranch, Stmt* elseBranch);
 
             virtual void* accept(Visitor<void*>* visitor) override;
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };
 }
\ No newline at end of file
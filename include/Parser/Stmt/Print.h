@@ -13,5 +13,6 @@ namespace Stmt
             Print(Expr::Expr* expression);
 
             virtual void* accept(Visitor<void*>* visitor) override;
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };
 } 
@@ -14,5 +14,6 @@ namespace Stmt {
         public:
             Return(Token* keyword, Expr::Expr* value);
             virtual void* accept(Visitor<void*>* visitor) override;
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };
 }
\ No newline at end of file
@@ -14,7 +14,32 @@ namespace Stmt {
     class Function;
     class Return;
     class Class;
-    
+
+    /**
+     * @brief How execution of a statement finished.
+     * Returned by the interpreter instead of unwinding the C++ stack
+     * so enclosing blocks and loops can stop early
+     */
+    enum Completion
+    {
+        COMPLETION_NORMAL,
+        COMPLETION_RETURN,
+        // Return of a call in tail position, which the
+        // function's own call runs next in the same frame
+        COMPLETION_TAIL_CALL
+    };
+
+    /**
+     * @brief Variable of the enclosing function captured by a closure,
+     * either the cell in slot index of its frame when isLocal
+     * or its own upvalue at index
+     */
+    struct Capture
+    {
+        int index;
+        bool isLocal;
+    };
+
     template <class T>
     class Visitor
     {
@@ -34,5 +59,6 @@ namespace Stmt {
     {
         public:
             virtual void* accept(Visitor<void*>* visitor);
+            virtual Completion accept(Visitor<Completion>* visitor);
     };
 }
\ No newline at end of file
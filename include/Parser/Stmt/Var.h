@@ -11,9 +11,13 @@ namespace Stmt
             Token* name;
             Expr::Expr* initializer;
 
+            // Where the resolver placed the variable
+            Expr::VariableKind kind;
+
         public:
             Var(Token* name, Expr::Expr* initializer);
 
             virtual void* accept(Visitor<void*>* visitor) override; 
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };  
 } 
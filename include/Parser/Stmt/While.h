@@ -13,5 +13,6 @@ namespace Stmt {
             While(Expr::Expr* condition, Stmt* body);
 
             virtual void* accept(Visitor<void*>* visitor) override;
+            virtual Completion accept(Visitor<Completion>* visitor) override;
     };
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <unordered_map>
 #include <vector>
 
 #include "./Token.h"
@@ -13,21 +12,27 @@ class Scanner {
             current,    // points to character being considered
             line;
 
-        std::string* source;         // Source Code
-        std::vector<Token*>* tokens;
-
-        std::unordered_map<std::string, TokenType>* keywords;
+        const Source* source;   // Source Code
+        std::vector<Token>* tokens;
 
     public:
-        Scanner(std::string* source);
-        std::vector<Token*>* scanTokens();
+        Scanner(const Source* source);
+
+        /**
+         * @brief Tokens are stored by value and refer to the source
+         * instead of copying their lexemes
+         * 
+         * @return std::vector<Token>* 
+         */
+        std::vector<Token>* scanTokens();
 
     private:
-        void fillKeywords();
+        // Type of the identifier between start and current
+        TokenType identifierType();
+        TokenType checkKeyword(int offset, const char* rest, TokenType type);
 
     private:
         void addToken(TokenType type);
-        void addToken(TokenType type, std::string* literal);
         char advance();
         void scanToken();
         bool isAtEnd();
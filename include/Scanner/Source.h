@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Text of a program, which tokens point into.
+ * Scripts are mapped straight from their file, so the scanner reads the
+ * page cache instead of a copy. Stdin, pipes and REPL lines are kept in
+ * a string instead. Either way it has to outlive every token
+ *
+ */
+class Source
+{
+    private:
+        const char* bytes;
+        std::size_t size;
+
+        // Set when the bytes are mapped from a file instead of owned
+        void* mapping;
+
+        // Owns the bytes when they are not mapped
+        std::string text;
+
+    public:
+        Source(const std::string& text);
+        Source(std::string&& text);
+        ~Source();
+
+        // Tokens keep pointers to it, so it is never copied
+        Source(const Source&) = delete;
+        Source& operator=(const Source&) = delete;
+
+    public:
+        /**
+         * @brief Maps a regular file read-only, other files are read once
+         * into memory. "-" reads the standard input
+         *
+         * @param path
+         * @param error set to a message if the file cant be read
+         * @return Source* nullptr on error
+         */
+        static Source* load(const std::string& path, std::string* error);
+
+    public:
+        const char* data() const { return bytes; }
+        std::size_t length() const { return size; }
+
+        // Unchecked, a mapped source has no terminator after length()
+        char operator[](std::size_t index) const { return bytes[index]; }
+
+        bool isMapped() const { return mapping != nullptr; }
+
+    private:
+        Source();
+};
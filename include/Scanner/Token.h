@@ -3,22 +3,47 @@
 #include <string>
 
 #include "./TokenType.h"
+#include "./Source.h"
 
+class LoxString;
+
+/**
+ * @brief Lexeme is not copied out of the source, the token only keeps
+ * its position. So the source buffer has to outlive every token,
+ * which the AST nodes keep pointing to
+ *
+ */
 class Token {
     public:
         TokenType type;
-        std::string* lexeme;
 
-        // This can be used as void*
-        std::string* literal;
+        // Position of lexeme in source
+        const Source* source;
+        int start;
+        int length;
+
         int line;
 
+        // Interned text of identifiers, this, and string literals
+        // without their quotes, nullptr for every other token
+        LoxString* interned;
+
+    public:
+        Token(TokenType type, const Source* source, int start, int length, int line);
+
     public:
-        Token(TokenType type, std::string* lexeme, std::string* literal, int line);
+        // Copy of the lexeme text, used for names and error messages
+        std::string lexeme() const;
+
+        // Compares lexemes without copying them
+        bool lexemeEquals(const Token* other) const;
+        bool lexemeEquals(const std::string& text) const;
+
+        // Literals are decoded only when the parser needs their value
+        double numberValue() const;
         
     public:
     // Overloads
     friend std::ostream& operator<<(std::ostream& os, const Token& t);
 
 };
-
@@ -0,0 +1,10 @@
+#pragma once
+
+// Kind of function whose body is being resolved or compiled
+enum FunctionType 
+{
+    NONE,
+    FUNCTION,
+    METHOD,
+    INITIALIZER
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <ostream>
+
+#include "./../Parser/Expression/ExpressionHeaders.h"
+#include "./../Parser/Stmt/StmtHeaders.h"
+
+class Arena;
+
+/**
+ * @brief Pass over resolved syntax trees, run before any backend.
+ * Binary, Unary, Logical and Grouping nodes whose operands are all literals
+ * are replaced by the Literal they evaluate to, and If and While statements
+ * with a literal condition lose the branches that can never run.
+ * Operations that would raise a runtime error are left for the backend
+ *
+ */
+class Optimizer:
+    public Expr::Visitor<std::string*>,
+    public Stmt::Visitor<void*>
+{
+    public:
+        // Set by --opt-stats
+        bool reportStats;
+
+        // Totals of the session
+        long foldedNodes;
+        long prunedBranches;
+
+    private:
+        // Arena of the tree being optimized, folded literals are allocated in it
+        Arena* arena;
+
+        // Replacement of the node whose visit just ended, if any
+        Expr::Expr* optimizedExpr;
+        // A statement replaced by nullptr is removed
+        bool replacedStmt;
+        Stmt::Stmt* optimizedStmt;
+
+    public:
+        Optimizer();
+
+        /**
+         * @brief Rewrites the statements in place
+         *
+         * @param statements
+         * @param arena owning the statements
+         */
+        void optimize(NodeList<Stmt::Stmt*>* statements, Arena* arena);
+
+        void printStats(std::ostream& os);
+
+    public:
+        virtual std::string* visitAssignExpr(Expr::Assign* expr) override;
+        virtual std::string* visitBinaryExpr(Expr::Binary* expr) override;
+        virtual std::string* visitCallExpr(Expr::Call* expr) override;
+        virtual std::string* visitGetExpr(Expr::Get* expr) override;
+        virtual std::string* visitGroupingExpr(Expr::Grouping* expr) override;
+        virtual std::string* visitLiteralExpr(Expr::Literal* expr) override;
+        virtual std::string* visitLogicalExpr(Expr::Logical* expr) override;
+        virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
+        virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
+        virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual std::string* visitThisExpr(Expr::This* expr) override;
+
+    public:
+        virtual void* visitBlockStmt(Stmt::Block* stmt) override;
+        virtual void* visitClassStmt(Stmt::Class* stmt) override;
+        virtual void* visitExpressionStmt(Stmt::Expression* stmt) override;
+        virtual void* visitFunctionStmt(Stmt::Function* stmt) override;
+        virtual void* visitIfStmt(Stmt::If* stmt) override;
+        virtual void* visitPrintStmt(Stmt::Print* stmt) override;
+        virtual void* visitReturnStmt(Stmt::Return* stmt) override;
+        virtual void* visitVarStmt(Stmt::Var* stmt) override;
+        virtual void* visitWhileStmt(Stmt::While* stmt) override;
+
+    private:
+        Expr::Expr* optimize(Expr::Expr* expr);
+        // Never nullptr, removed statements become an empty block
+        Stmt::Stmt* optimize(Stmt::Stmt* stmt);
+        // Removed statements are dropped from the list
+        void optimize(NodeList<Stmt::Stmt*>* statements);
+
+        // Replaces the visited node with a literal
+        void fold(Value value);
+        // Result of a constant operation, false if it raises a runtime error
+        bool evaluateBinary(TokenType operator_, Value left, Value right, Value* result);
+        bool isTruthy(Value value);
+};
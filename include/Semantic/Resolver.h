@@ -1,17 +1,58 @@
 #pragma once
 
-#include <stack>
+#include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "./../Parser/Expression/ExpressionHeaders.h"
 #include "./../Parser/Stmt/StmtHeaders.h"
+#include "./FunctionType.h"
 
 class Interpreter;
+class Arena;
 
-enum FunctionType 
+// Whether the code being resolved is inside a class body
+// Prefixed since unscoped enums share the global namespace with TokenType
+enum ClassType
 {
-    NONE,
-    FUNCTION
+    CLASS_NONE,
+    CLASS_BODY
+};
+
+/**
+ * @brief Static information tracked for each declared local variable
+ * slot is the index of the variable in its function's frame
+ */
+struct LocalVariable
+{
+    int slot;
+    // Whether the variable has finished resolving its initializer
+    bool defined;
+    // Parameters and receivers are boxed by the call instead of a declaration
+    bool isParameter;
+
+    // Whether a closure captures it, so it has to live in a cell
+    bool captured;
+    // Kinds written by the declaration and by uses from its own function,
+    // rewritten to cells once a closure captures the variable
+    std::vector<Expr::VariableKind*> kinds;
+};
+
+/**
+ * @brief Frame layout of the function being resolved.
+ * Top level code is a function too, whose frame holds the locals of blocks
+ */
+struct FunctionScope
+{
+    FunctionScope* enclosing;
+    // Index in scopes of the function's outermost scope
+    int firstScope;
+
+    // Locals alive at this point, and the most alive at once
+    int slotCount;
+    int maxSlots;
+
+    std::vector<Stmt::Capture> upvalues;
 };
 
 class Resolver: 
@@ -21,18 +62,30 @@ public Stmt::Visitor<void*>
     private:
         // Keeping track whether or not the code is inside a function declaration
         FunctionType currentFunction;
+        ClassType currentClass;
 
     public:
         // Each element in stack represents a single block scope.
         // Scope stack is only for local block scopes
         // Global scope is not tracked by resolver
-        std::stack<std::unordered_map<std::string, bool>*>* scopes;
+        std::vector<std::unordered_map<LoxString*, LocalVariable>*>* scopes;
+
+    private:
+        FunctionScope* function;
 
     public: 
         Interpreter* interpreter;
 
+        // Owner of the syntax tree, frame layouts are allocated next to it
+        Arena* arena;
+
+        // Whether a function or class was declared, their runtime objects
+        // keep pointing into the syntax tree after the program ran
+        bool declaresFunctions;
+
     public:
-        Resolver(Interpreter* interpreter);
+        Resolver(Interpreter* interpreter, Arena* arena);
+        ~Resolver();
 
     // Environment maps are read when we resolve variable expressions
     public:
@@ -46,6 +99,7 @@ public Stmt::Visitor<void*>
         virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
         virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
         virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual std::string* visitThisExpr(Expr::This* expr) override;
 
     public:
         virtual void* visitBlockStmt(Stmt::Block* stmt) override;
@@ -59,16 +113,30 @@ public Stmt::Visitor<void*>
         virtual void* visitWhileStmt(Stmt::While* stmt) override;
 
     public:
-        void resolve(std::vector<Stmt::Stmt*>* statements);
+        void resolve(NodeList<Stmt::Stmt*>* statements);
 
     private:
         void beginScope();
         void endScope();
         void resolve(Stmt::Stmt* statement);
         void resolve(Expr::Expr* statement);
-        void resolveLocal(Expr::Expr* expr, Token* name);
+        /**
+         * @brief Finds the scope declaring name and writes its location
+         * into kind and slot of the variable's syntax node.
+         * Both are left untouched for globals
+         */
+        void resolveLocal(Token* name, Expr::VariableKind* kind, int* slot);
+        // Index of the upvalue of function reaching the slot of a function enclosing it
+        int resolveUpvalue(FunctionScope* function, int slot, int scopeIndex);
+        int addUpvalue(FunctionScope* function, int index, bool isLocal);
+        void capture(LocalVariable* variable);
         void resolveFunction(Stmt::Function* stmt, FunctionType type);
-        void declare(Token* name);
+
+        // Declares into the current scope, kind is set unless the declaration is global
+        void declare(Token* name, Expr::VariableKind* kind);
+        void declareParameter(Token* name);
+        // Adds a local in the next slot of the frame
+        LocalVariable* addLocal(LoxString* name);
         void define(Token* name);
 };
 
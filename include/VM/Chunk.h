@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "./OpCode.h"
+#include "./../Interpreter/Value.h"
+
+/**
+ * @brief Compiled bytecode of a single function along with
+ * its constant pool and line table
+ *
+ */
+class Chunk
+{
+    public:
+        std::vector<uint8_t> code;
+        std::vector<Value> constants;
+
+    private:
+        // Run length encoded line table
+        // Each entry holds the first code offset of a run and its source line
+        std::vector<std::pair<int, int>> lines;
+
+    public:
+        void write(uint8_t byte, int line);
+        int addConstant(Value value);
+
+        /**
+         * @brief Source line of the instruction at offset, used for runtime errors
+         *
+         * @param offset
+         * @return int
+         */
+        int getLine(int offset);
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "./../Parser/Expression/ExpressionHeaders.h"
+#include "./../Parser/Stmt/StmtHeaders.h"
+#include "./../Semantic/FunctionType.h"
+#include "./Chunk.h"
+#include "./VmFunction.h"
+
+class VM;
+
+/**
+ * @brief Local variable living in a stack slot of the function being compiled
+ */
+struct CompilerLocal
+{
+    // nullptr for the callee slot of functions, which user code cannot name
+    // Methods name it 'this' since it holds their receiver
+    Token* name;
+    // Scope depth of declaration, -1 while its initializer is compiled
+    int depth;
+    // Whether a closure captures it, so leaving scope has to close an upvalue
+    bool isCaptured;
+};
+
+/**
+ * @brief Variable captured by the function being compiled.
+ * isLocal tells if index is a stack slot of the enclosing function
+ * or one of the enclosing function's own upvalues
+ */
+struct CompilerUpvalue
+{
+    uint8_t index;
+    bool isLocal;
+};
+
+/**
+ * @brief Compilation state of one function, nested functions
+ * link to the state of their enclosing function
+ */
+class FunctionState
+{
+    public:
+        VmFunction* function;
+        FunctionState* enclosing;
+        FunctionType type;
+
+        std::vector<CompilerLocal> locals;
+        std::vector<CompilerUpvalue> upvalues;
+        int scopeDepth;
+
+    public:
+        FunctionState(VmFunction* function, FunctionState* enclosing, FunctionType type);
+};
+
+/**
+ * @brief Compiles resolved statements into bytecode for the VM.
+ * Locals are assigned stack slots, variables captured by closures become
+ * upvalues and globals are bound to slots of the VM's global table
+ *
+ */
+class Compiler:
+    public Expr::Visitor<std::string*>,
+    public Stmt::Visitor<void*>
+{
+    private:
+        VM* vm;
+        FunctionState* current;
+
+        // Source line attached to emitted instructions
+        int line;
+
+    public:
+        Compiler(VM* vm);
+
+        /**
+         * @brief Compiles a whole program into the top level script function
+         *
+         * @param statements
+         * @return VmFunction*
+         */
+        VmFunction* compile(NodeList<Stmt::Stmt*>* statements);
+
+    public:
+        virtual std::string* visitAssignExpr(Expr::Assign* expr) override;
+        virtual std::string* visitBinaryExpr(Expr::Binary* expr) override;
+        virtual std::string* visitCallExpr(Expr::Call* expr) override;
+        virtual std::string* visitGetExpr(Expr::Get* expr) override;
+        virtual std::string* visitGroupingExpr(Expr::Grouping* expr) override;
+        virtual std::string* visitLiteralExpr(Expr::Literal* expr) override;
+        virtual std::string* visitLogicalExpr(Expr::Logical* expr) override;
+        virtual std::string* visitUnaryExpr(Expr::Unary* expr) override;
+        virtual std::string* visitVariableExpr(Expr::Variable* expr) override;
+        virtual std::string* visitSetExpr(Expr::Set* expr) override;
+        virtual std::string* visitThisExpr(Expr::This* expr) override;
+
+    public:
+        virtual void* visitBlockStmt(Stmt::Block* stmt) override;
+        virtual void* visitClassStmt(Stmt::Class* stmt) override;
+        virtual void* visitExpressionStmt(Stmt::Expression* stmt) override;
+        virtual void* visitFunctionStmt(Stmt::Function* stmt) override;
+        virtual void* visitIfStmt(Stmt::If* stmt) override;
+        virtual void* visitPrintStmt(Stmt::Print* stmt) override;
+        virtual void* visitReturnStmt(Stmt::Return* stmt) override;
+        virtual void* visitVarStmt(Stmt::Var* stmt) override;
+        virtual void* visitWhileStmt(Stmt::While* stmt) override;
+
+    private:
+        void compile(Stmt::Stmt* stmt);
+        void compile(Expr::Expr* expr);
+        void compileFunction(Stmt::Function* stmt, FunctionType type);
+
+    private:
+        // Bytecode emission
+        Chunk* currentChunk();
+        void emitByte(uint8_t byte);
+        void emitBytes(uint8_t first, uint8_t second);
+        void emitShort(uint16_t value);
+        void emitConstant(Value value);
+        // Initializers return their receiver instead of nil
+        void emitReturn();
+        uint16_t makeConstant(Value value);
+        uint16_t identifierConstant(Token* name);
+
+        // Operand of global instructions, reports an error past UINT16_MAX
+        uint16_t globalSlot(Token* name);
+        int emitJump(uint8_t instruction);
+        void patchJump(int offset);
+        void emitLoop(int loopStart);
+
+    private:
+        // Variable handling
+        void beginScope();
+        void endScope();
+        void declareVariable(Token* name);
+        void markInitialized();
+        void defineVariable(Token* name);
+        void namedVariable(Token* name, bool isAssignment);
+        int resolveLocal(FunctionState* state, Token* name);
+        int resolveUpvalue(FunctionState* state, Token* name);
+        int addUpvalue(FunctionState* state, uint8_t index, bool isLocal);
+};
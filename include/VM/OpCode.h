@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * @brief Instructions understood by the VM.
+ * Operand sizes are listed next to each instruction, u16 operands are big endian
+ */
+enum OpCode
+{
+    OP_CONSTANT,        // u16 constant index
+    OP_NIL,
+    OP_TRUE,
+    OP_FALSE,
+    OP_POP,
+
+    OP_GET_LOCAL,       // u8 stack slot
+    OP_SET_LOCAL,       // u8 stack slot
+    OP_GET_GLOBAL,      // u16 global slot
+    OP_DEFINE_GLOBAL,   // u16 global slot
+    OP_SET_GLOBAL,      // u16 global slot
+    OP_GET_UPVALUE,     // u8 upvalue index
+    OP_SET_UPVALUE,     // u8 upvalue index
+    OP_GET_PROPERTY,    // u16 constant index of property name
+    OP_SET_PROPERTY,    // u16 constant index of property name
+
+    OP_EQUAL,
+    OP_NOT_EQUAL,
+    OP_GREATER,
+    OP_GREATER_EQUAL,
+    OP_LESS,
+    OP_LESS_EQUAL,
+    OP_ADD,
+    OP_SUBTRACT,
+    OP_MULTIPLY,
+    OP_DIVIDE,
+    OP_NOT,
+    OP_NEGATE,
+
+    OP_PRINT,
+    OP_JUMP,            // u16 forward offset
+    OP_JUMP_IF_FALSE,   // u16 forward offset, condition is left on stack
+    OP_LOOP,            // u16 backward offset
+    OP_CALL,            // u8 arguement count
+    OP_INVOKE,          // u16 constant index of method name, u8 arguement count
+    OP_TAIL_CALL,       // u8 arguement count, followed by OP_RETURN
+    OP_TAIL_INVOKE,     // same operands as OP_INVOKE, followed by OP_RETURN
+    OP_CLOSURE,         // u16 constant index, then (u8 isLocal, u8 index) per upvalue
+    OP_CLOSE_UPVALUE,
+    OP_RETURN,
+    OP_CLASS,           // u16 constant index of class name
+    OP_METHOD           // u16 constant index of method name, class and closure are on stack
+};
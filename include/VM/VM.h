@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "./Chunk.h"
+#include "./Compiler.h"
+#include "./VmFunction.h"
+#include "./VmClosure.h"
+#include "./VmUpvalue.h"
+#include "./../Interpreter/RuntimeHeaders.h"
+
+/**
+ * @brief Activation record of a VM function call
+ */
+struct CallFrame
+{
+    VmClosure* closure;
+    uint8_t* ip;
+    // First stack slot of the frame, holding the callee
+    Value* slots;
+};
+
+/**
+ * @brief Stack based virtual machine executing bytecode compiled from
+ * the resolved syntax tree. Selected with --vm, the tree walking
+ * Interpreter stays the reference implementation
+ *
+ */
+class VM: public GcRootProvider
+{
+    public:
+        // The frame of the script comes on top of the calls it makes
+        static const int FRAMES_MAX = LoxCallable::MAX_CALL_DEPTH + 1;
+        static const int STACK_MAX = FRAMES_MAX * 256;
+
+    public:
+        Heap* heap;
+
+    private:
+        Value* stack;
+        Value* stackTop;
+
+        CallFrame* frames;
+        int frameCount;
+
+        // Upvalues still pointing into the stack, sorted from top to bottom
+        VmUpvalue* openUpvalues;
+
+        // Globals are bound to slots at compile time
+        // Name table is kept for the whole session so REPL lines share globals
+        std::unordered_map<std::string, int>* globalSlots;
+        std::vector<std::string>* globalNames;
+        std::vector<Value>* globals;
+        std::vector<bool>* globalDefined;
+
+    public:
+        VM();
+
+    public:
+        /**
+         * @brief Compiles and runs already resolved statements
+         *
+         * @param statements
+         */
+        void interpret(NodeList<Stmt::Stmt*>* statements);
+
+        /**
+         * @brief Slot of a global name, reserving an undefined one on first use
+         *
+         * @param name
+         * @return int
+         */
+        int globalSlot(const std::string& name);
+
+        virtual void markRoots(Heap* heap) override;
+
+    private:
+        bool run();
+        void defineNative(std::string name, LoxCallable* native);
+
+    private:
+        void push(Value value);
+        Value pop();
+        Value peek(int distance);
+        void resetStack();
+
+    private:
+        // A tail call replaces the current frame when the callee is a closure
+        bool callValue(Value callee, int argCount, bool tail);
+        bool call(VmClosure* closure, int argCount, bool tail);
+        // Calls a method of the receiver sitting below the arguements
+        bool invoke(LoxString* name, int argCount, bool tail);
+        // Replaces the instance on top of the stack by its bound method
+        bool bindMethod(LoxClass* klass, LoxString* name);
+        bool checkArity(int arity, int argCount);
+        VmUpvalue* captureUpvalue(Value* local);
+        void closeUpvalues(Value* last);
+
+    private:
+        bool isTruthy(Value value);
+
+        // Reports the error at the line of the current instruction
+        void runtimeError(std::string message);
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "./VmFunction.h"
+#include "./VmUpvalue.h"
+
+/**
+ * @brief Runtime function value of the VM, a compiled function
+ * together with the variables it captured
+ *
+ */
+class VmClosure: public LoxObject
+{
+    public:
+        VmFunction* function;
+        std::vector<VmUpvalue*> upvalues;
+
+    public:
+        VmClosure(VmFunction* function);
+
+    public:
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+#include "./Chunk.h"
+#include "./../Interpreter/LoxObject.h"
+#include "./../Interpreter/LoxString.h"
+
+/**
+ * @brief Function compiled to bytecode.
+ * Created once by the compiler, each evaluation of the declaration
+ * wraps it in a new VmClosure
+ *
+ */
+class VmFunction: public LoxObject
+{
+    public:
+        int arity;
+        int upvalueCount;
+        Chunk chunk;
+
+        // nullptr for the top level script
+        LoxString* name;
+
+    public:
+        VmFunction(LoxString* name);
+
+    public:
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
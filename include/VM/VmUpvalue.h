@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+
+#include "./../Interpreter/LoxObject.h"
+#include "./../Interpreter/Value.h"
+
+/**
+ * @brief Variable captured by a closure.
+ * While the variable is on the VM stack, location points into the stack,
+ * once its scope ends the value moves into closed and location points to it
+ *
+ */
+class VmUpvalue: public LoxObject
+{
+    public:
+        Value* location;
+        Value closed;
+
+        // Next open upvalue, sorted by stack slot from top to bottom
+        VmUpvalue* nextOpen;
+
+    public:
+        VmUpvalue(Value* location);
+
+    public:
+        virtual std::string toString() override;
+        virtual void trace(Heap* heap) override;
+        virtual std::size_t size() override;
+};
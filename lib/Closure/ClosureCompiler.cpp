@@ -0,0 +1,638 @@
+#include "./../../include/Closure/ClosureCompiler.h"
+
+ClosureCompiler::ClosureCompiler(Interpreter* interpreter)
+{
+    this->interpreter = interpreter;
+}
+
+void ClosureCompiler::interpret(NodeList<Stmt::Stmt*>* statements)
+{
+    // Compiled blocks are never freed, functions declared by the
+    // program keep running their bodies after it finished
+    interpreter->interpret(compile(statements));
+}
+
+CompiledExpr ClosureCompiler::compile(Expr::Expr* expr)
+{
+    expr->accept(this);
+    return compiledExpr;
+}
+
+CompiledStmt ClosureCompiler::compile(Stmt::Stmt* stmt)
+{
+    stmt->accept(this);
+    return compiledStmt;
+}
+
+CompiledBlock* ClosureCompiler::compile(NodeList<Stmt::Stmt*>* statements)
+{
+    CompiledBlock* block = new CompiledBlock();
+    block->statements.reserve(statements->size());
+
+    for (Stmt::Stmt* statement: *statements) {
+        block->statements.push_back(compile(statement));
+    }
+
+    return block;
+}
+
+std::vector<CompiledExpr> ClosureCompiler::compile(NodeList<Expr::Expr*>* arguments)
+{
+    std::vector<CompiledExpr> compiled;
+    compiled.reserve(arguments->size());
+
+    for (Expr::Expr* argument: *arguments) {
+        compiled.push_back(compile(argument));
+    }
+
+    return compiled;
+}
+
+std::string* ClosureCompiler::visitLiteralExpr(Expr::Literal* expr)
+{
+    Value value = expr->value;
+
+    compiledExpr = [value]() -> Value {
+        return value;
+    };
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitGroupingExpr(Expr::Grouping* expr)
+{
+    // Parentheses only shaped the tree, nothing is left to do at runtime
+    compiledExpr = compile(expr->expression);
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitUnaryExpr(Expr::Unary* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* operator_ = expr->operator_;
+    CompiledExpr right = compile(expr->right);
+
+    if (operator_->type == TokenType::MINUS) {
+        compiledExpr = [interpreter, operator_, right]() -> Value {
+            Value value = right();
+            interpreter->checkNumberOperand(operator_, value);
+
+            return Value::fromNumber(-value.asNumber());
+        };
+    } else {
+        compiledExpr = [interpreter, right]() -> Value {
+            return Value::fromBool(!interpreter->isTruthy(right()));
+        };
+    }
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitBinaryExpr(Expr::Binary* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+
+    Expr::Binary* addition = dynamic_cast<Expr::Binary*>(expr->left);
+    if (expr->operator_->type == TokenType::PLUS
+        && addition != nullptr && addition->operator_->type == TokenType::PLUS
+    ) {
+        compiledExpr = compileAdditionChain(expr);
+        return nullptr;
+    }
+
+    CompiledExpr left = compile(expr->left);
+    CompiledExpr right = compile(expr->right);
+
+    // Operator is picked once here instead of switched on for every evaluation
+    // Left operand is not rooted, an object there is never read since
+    // arithmetic and comparisons throw for it
+    #define NUMBER_OPERATION(valueType, op) \
+        [interpreter, expr, left, right]() -> Value { \
+            Value a = left(); \
+            Value b = right(); \
+            if (a.isNumber() && b.isNumber()) { \
+                return Value::valueType(a.asNumber() op b.asNumber()); \
+            } \
+            return interpreter->binaryOperation(expr, a, b); \
+        }
+
+    switch (expr->operator_->type) {
+        case TokenType::MINUS: compiledExpr = NUMBER_OPERATION(fromNumber, -); break;
+        case TokenType::STAR: compiledExpr = NUMBER_OPERATION(fromNumber, *); break;
+        case TokenType::SLASH: compiledExpr = NUMBER_OPERATION(fromNumber, /); break;
+        case TokenType::GREATER: compiledExpr = NUMBER_OPERATION(fromBool, >); break;
+        case TokenType::GREATER_EQUAL: compiledExpr = NUMBER_OPERATION(fromBool, >=); break;
+        case TokenType::LESS: compiledExpr = NUMBER_OPERATION(fromBool, <); break;
+        case TokenType::LESS_EQUAL: compiledExpr = NUMBER_OPERATION(fromBool, <=); break;
+
+        case TokenType::PLUS:
+            compiledExpr = [interpreter, expr, left, right]() -> Value {
+                Value a = left();
+                Value b = evaluateRight(interpreter, a, right);
+
+                if (a.isNumber() && b.isNumber()) {
+                    return Value::fromNumber(a.asNumber() + b.asNumber());
+                }
+
+                // Concatenation and type errors
+                return interpreter->binaryOperation(expr, a, b);
+            };
+            break;
+
+        case TokenType::EQUAL_EQUAL:
+            compiledExpr = [interpreter, left, right]() -> Value {
+                Value a = left();
+                Value b = evaluateRight(interpreter, a, right);
+
+                return Value::fromBool(interpreter->isEqual(a, b));
+            };
+            break;
+
+        case TokenType::BANG_EQUAL:
+            compiledExpr = [interpreter, left, right]() -> Value {
+                Value a = left();
+                Value b = evaluateRight(interpreter, a, right);
+
+                return Value::fromBool(!interpreter->isEqual(a, b));
+            };
+            break;
+
+        default:
+            compiledExpr = [interpreter, expr, left, right]() -> Value {
+                Value a = left();
+                Value b = evaluateRight(interpreter, a, right);
+
+                return interpreter->binaryOperation(expr, a, b);
+            };
+            break;
+    }
+
+    #undef NUMBER_OPERATION
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitLogicalExpr(Expr::Logical* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledExpr left = compile(expr->left);
+    CompiledExpr right = compile(expr->right);
+
+    if (expr->operator_->type == TokenType::OR) {
+        compiledExpr = [interpreter, left, right]() -> Value {
+            Value value = left();
+            return interpreter->isTruthy(value) ? value : right();
+        };
+    } else {
+        compiledExpr = [interpreter, left, right]() -> Value {
+            Value value = left();
+            return interpreter->isTruthy(value) ? right() : value;
+        };
+    }
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitVariableExpr(Expr::Variable* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* name = expr->name;
+    int slot = expr->slot;
+
+    switch (expr->kind) {
+        case Expr::VARIABLE_GLOBAL: {
+            // Global slots never change, so they are bound at compile time
+            Environment* globals = interpreter->globals;
+            int global = globals->globalSlot(name->interned);
+
+            compiledExpr = [globals, name, global]() -> Value {
+                return globals->get(name, global);
+            };
+            break;
+        }
+
+        case Expr::VARIABLE_LOCAL:
+            compiledExpr = [interpreter, slot]() -> Value {
+                return interpreter->frame[slot];
+            };
+            break;
+
+        default: {
+            Expr::VariableKind kind = expr->kind;
+
+            compiledExpr = [interpreter, kind, slot]() -> Value {
+                return interpreter->getLocal(kind, slot);
+            };
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitAssignExpr(Expr::Assign* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* name = expr->name;
+    int slot = expr->slot;
+    CompiledExpr value = compile(expr->value);
+
+    switch (expr->kind) {
+        case Expr::VARIABLE_GLOBAL: {
+            Environment* globals = interpreter->globals;
+            int global = globals->globalSlot(name->interned);
+
+            compiledExpr = [globals, name, global, value]() -> Value {
+                Value assigned = value();
+                globals->assign(name, global, assigned);
+
+                return assigned;
+            };
+            break;
+        }
+
+        case Expr::VARIABLE_LOCAL:
+            compiledExpr = [interpreter, slot, value]() -> Value {
+                Value assigned = value();
+                interpreter->frame[slot] = assigned;
+
+                return assigned;
+            };
+            break;
+
+        default: {
+            Expr::VariableKind kind = expr->kind;
+
+            compiledExpr = [interpreter, kind, slot, value]() -> Value {
+                Value assigned = value();
+                interpreter->assignLocal(kind, slot, assigned);
+
+                return assigned;
+            };
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitThisExpr(Expr::This* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Expr::VariableKind kind = expr->kind;
+    int slot = expr->slot;
+
+    compiledExpr = [interpreter, kind, slot]() -> Value {
+        return interpreter->getLocal(kind, slot);
+    };
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitCallExpr(Expr::Call* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    std::vector<CompiledExpr> arguments = compile(expr->arguments);
+
+    if (expr->method != nullptr) {
+        // Method call sites share the inline cache of their syntax node
+        CompiledExpr object = compile(expr->method->object);
+
+        compiledExpr = [interpreter, expr, object, arguments]() -> Value {
+            Value receiver = object();
+            Value callee;
+
+            if (interpreter->methodCallee(expr, receiver, &callee)) {
+                return call(interpreter, expr, callee, &receiver, arguments);
+            }
+
+            return call(interpreter, expr, callee, nullptr, arguments);
+        };
+    } else {
+        CompiledExpr callee = compile(expr->callee);
+
+        compiledExpr = [interpreter, expr, callee, arguments]() -> Value {
+            return call(interpreter, expr, callee(), nullptr, arguments);
+        };
+    }
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitGetExpr(Expr::Get* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* name = expr->name;
+    CompiledExpr object = compile(expr->object);
+
+    compiledExpr = [interpreter, name, object]() -> Value {
+        return interpreter->getProperty(name, object());
+    };
+
+    return nullptr;
+}
+
+std::string* ClosureCompiler::visitSetExpr(Expr::Set* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* name = expr->name;
+    CompiledExpr object = compile(expr->object);
+    CompiledExpr value = compile(expr->value);
+
+    compiledExpr = [interpreter, name, object, value]() -> Value {
+        Value target = object();
+
+        if (!target.isInstance()) {
+            throw new RuntimeError(name,
+                "Only instances have fields."
+            );
+        }
+
+        interpreter->heap->pushRoot(target);
+        Value assigned = value();
+        interpreter->heap->popRoots(1);
+
+        target.asInstance()->setField(name->interned, assigned);
+        interpreter->heap->grew(target.asInstance());
+
+        return assigned;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitExpressionStmt(Stmt::Expression* stmt)
+{
+    CompiledExpr expression = compile(stmt->expression);
+
+    compiledStmt = [expression]() -> Stmt::Completion {
+        expression();
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitPrintStmt(Stmt::Print* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledExpr expression = compile(stmt->expression);
+
+    compiledStmt = [interpreter, expression]() -> Stmt::Completion {
+        Lox::output->print(expression());
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitVarStmt(Stmt::Var* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    Token* name = stmt->name;
+    Expr::VariableKind kind = stmt->kind;
+
+    if (stmt->initializer == nullptr) {
+        compiledStmt = [interpreter, name, kind]() -> Stmt::Completion {
+            interpreter->define(name, kind, Value());
+            return Stmt::COMPLETION_NORMAL;
+        };
+
+        return nullptr;
+    }
+
+    CompiledExpr initializer = compile(stmt->initializer);
+
+    compiledStmt = [interpreter, name, kind, initializer]() -> Stmt::Completion {
+        interpreter->define(name, kind, initializer());
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitBlockStmt(Stmt::Block* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledBlock* block = compile(stmt->statements);
+
+    if (stmt->localCount == 0) {
+        compiledStmt = [interpreter, block]() -> Stmt::Completion {
+            return interpreter->executeStatements(block);
+        };
+
+        return nullptr;
+    }
+
+    compiledStmt = [interpreter, block]() -> Stmt::Completion {
+        return interpreter->executeBlock(block);
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitIfStmt(Stmt::If* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledExpr condition = compile(stmt->condition);
+    CompiledStmt thenBranch = compile(stmt->thenBranch);
+
+    if (stmt->elseBranch == nullptr) {
+        compiledStmt = [interpreter, condition, thenBranch]() -> Stmt::Completion {
+            if (interpreter->isTruthy(condition())) {
+                return thenBranch();
+            }
+
+            return Stmt::COMPLETION_NORMAL;
+        };
+
+        return nullptr;
+    }
+
+    CompiledStmt elseBranch = compile(stmt->elseBranch);
+
+    compiledStmt = [interpreter, condition, thenBranch, elseBranch]() -> Stmt::Completion {
+        if (interpreter->isTruthy(condition())) {
+            return thenBranch();
+        }
+
+        return elseBranch();
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitWhileStmt(Stmt::While* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledExpr condition = compile(stmt->condition);
+    CompiledStmt body = compile(stmt->body);
+
+    compiledStmt = [interpreter, condition, body]() -> Stmt::Completion {
+        while (interpreter->isTruthy(condition())) {
+            Stmt::Completion completion = body();
+
+            // A return inside the loop body leaves the loop too
+            if (completion != Stmt::COMPLETION_NORMAL) {
+                return completion;
+            }
+        }
+
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitFunctionStmt(Stmt::Function* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    CompiledBlock* body = compile(stmt->body);
+
+    compiledStmt = [interpreter, stmt, body]() -> Stmt::Completion {
+        interpreter->defineFunction(stmt, body);
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitReturnStmt(Stmt::Return* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+
+    if (stmt->value == nullptr) {
+        compiledStmt = [interpreter]() -> Stmt::Completion {
+            interpreter->returnValue = Value();
+            return Stmt::COMPLETION_RETURN;
+        };
+
+        return nullptr;
+    }
+
+    CompiledExpr value = compile(stmt->value);
+
+    compiledStmt = [interpreter, value]() -> Stmt::Completion {
+        interpreter->returnValue = value();
+        return interpreter->returnCompletion();
+    };
+
+    return nullptr;
+}
+
+void* ClosureCompiler::visitClassStmt(Stmt::Class* stmt)
+{
+    Interpreter* interpreter = this->interpreter;
+    // Kept for the whole session like the compiled bodies themselves
+    std::vector<CompiledBlock*>* bodies = new std::vector<CompiledBlock*>();
+
+    for (Stmt::Function* method: *stmt->methods) {
+        bodies->push_back(compile(method->body));
+    }
+
+    compiledStmt = [interpreter, stmt, bodies]() -> Stmt::Completion {
+        interpreter->defineClass(stmt, bodies);
+        return Stmt::COMPLETION_NORMAL;
+    };
+
+    return nullptr;
+}
+
+CompiledExpr ClosureCompiler::compileAdditionChain(Expr::Binary* expr)
+{
+    Interpreter* interpreter = this->interpreter;
+
+    // Additions from the outermost one, the innermost runs first
+    std::vector<Expr::Binary*> additions;
+    Expr::Expr* first = expr;
+
+    for (Expr::Binary* addition = expr;
+        addition != nullptr && addition->operator_->type == TokenType::PLUS;
+        addition = dynamic_cast<Expr::Binary*>(addition->left)
+    ) {
+        additions.push_back(addition);
+        first = addition->left;
+    }
+
+    CompiledExpr head = compile(first);
+    std::vector<CompiledExpr> operands;
+    std::vector<Token*> operators;
+
+    for (std::size_t i = additions.size(); i > 0; i--) {
+        operands.push_back(compile(additions[i - 1]->right));
+        operators.push_back(additions[i - 1]->operator_);
+    }
+
+    return [interpreter, head, operands, operators]() -> Value {
+        Value sum = head();
+        std::string builder;
+
+        for (std::size_t i = 0; i < operands.size(); i++) {
+            Value operand = evaluateRight(interpreter, sum, operands[i]);
+            interpreter->addOperand(operators[i], &sum, &builder, operand);
+        }
+
+        if (!sum.isString()) {
+            return sum;
+        }
+
+        interpreter->heap->pushRoot(sum);
+        Value result = interpreter->finishAddition(sum, &builder);
+        interpreter->heap->popRoots(1);
+
+        return result;
+    };
+}
+
+Value ClosureCompiler::evaluateRight(Interpreter* interpreter, Value left, const CompiledExpr& right)
+{
+    if (!left.isObject()) {
+        return right();
+    }
+
+    // Right operand can allocate and trigger a collection
+    interpreter->heap->pushRoot(left);
+    Value value = right();
+    interpreter->heap->popRoots(1);
+
+    return value;
+}
+
+Value ClosureCompiler::call(
+    Interpreter* interpreter,
+    Expr::Call* expr,
+    Value callee,
+    Value* receiver,
+    const std::vector<CompiledExpr>& arguments
+)
+{
+    Heap* heap = interpreter->heap;
+    heap->pushRoot(callee);
+
+    // Same layout as Interpreter::call, the frame of a Lox function
+    // starts at the pushed receiver or first arguement
+    Value* base = interpreter->stackTop;
+
+    if (receiver != nullptr) {
+        interpreter->pushArgument(expr->paren, *receiver);
+        receiver = base;
+    }
+
+    Value* values = interpreter->stackTop;
+
+    for (const CompiledExpr& argument: arguments) {
+        interpreter->pushArgument(expr->paren, argument());
+    }
+
+    ArgumentSpan span(values, interpreter->stackTop - values);
+
+    Value result;
+    if (!expr->tailCall || !interpreter->scheduleTailCall(callee, receiver, span)) {
+        result = interpreter->callValue(expr->paren, callee, receiver, span);
+    }
+
+    interpreter->stackTop = base;
+    heap->popRoots(1);
+
+    return result;
+}
@@ -1,73 +1,81 @@
 #include "./../../include/Interpreter/Environment.h"
+#include "./../../include/Interpreter/Heap.h"
 
 Environment::Environment()
 {
-    this->values = new std::unordered_map<std::string, void*>();
-    this->enclosing = nullptr;
+    this->globalSlots = new std::unordered_map<LoxString*, int>();
+    this->defined = new std::vector<bool>();
 }
 
-Environment::Environment(Environment* enclosing)
+Environment::~Environment()
 {
-    this->values = new std::unordered_map<std::string, void*>();
-    this->enclosing = enclosing;
+    delete globalSlots;
+    delete defined;
 }
 
-void Environment::define(std::string* name, void* value)
+void Environment::trace(Heap* heap)
 {
-    // Not checking existing variable for redefinition
-    (*values)[*name] = value;
+    for (Value value: slots) {
+        heap->markValue(value);
+    }
 }
 
-void* Environment::get(Token* name)
+std::size_t Environment::size()
 {
-    if (values->find(*(name->lexeme)) != values->end()) {
-        return values->at(*(name->lexeme));
-    }
-
-    if (enclosing != nullptr) {
-        // Recursively searches in enclosing environment
-        return enclosing->get(name);
-    }
-
-    throw new RuntimeError(name, "Undefined variable '" + *(name->lexeme) + "'.");
+    return sizeof(Environment) + slots.capacity() * sizeof(Value);
 }
 
-void Environment::assign(Token* name, void* value)
+int Environment::globalSlot(LoxString* name)
 {
-    if (values->find(*(name->lexeme)) != values->end()) {
-        (*values)[*(name->lexeme)] = value;
-        return;
-    }
+    std::unordered_map<LoxString*, int>::iterator slot = globalSlots->find(name);
 
-    if (enclosing != nullptr) {
-        // Recursively look for name to assign too
-        enclosing->assign(name, value);
-        return;
+    if (slot != globalSlots->end()) {
+        return slot->second;
     }
 
-    throw new RuntimeError(name, "Undefined variable '" + *name->lexeme + "'.");
+    int newSlot = slots.size();
+    (*globalSlots)[name] = newSlot;
+    slots.push_back(Value());
+    defined->push_back(false);
+
+    return newSlot;
 }
 
+void Environment::define(LoxString* name, Value value)
+{
+    // Redefinition reuses the existing slot
+    int slot = globalSlot(name);
+
+    slots[slot] = value;
+    (*defined)[slot] = true;
+}
 
-void* Environment::getAt(int distance, std::string name)
+Value Environment::get(Token* name, int slot)
 {
-    // No need to check for variable existence
-    // Since the resolver already found it and 
-    // declared it in locals
-    return ancestor(distance)->values->at(name);
+    if ((*defined)[slot]) {
+        return slots[slot];
+    }
+
+    throw new RuntimeError(name, "Undefined variable '" + name->lexeme() + "'.");
 }
 
-void Environment::assignAt(int distance, Token* name, void* value)
+bool Environment::tryGet(int slot, Value* value)
 {
-    (*ancestor(distance)->values)[*name->lexeme] = value;
+    if (!(*defined)[slot]) {
+        return false;
+    }
+
+    *value = slots[slot];
+
+    return true;
 }
 
-Environment* Environment::ancestor(int distance)
+void Environment::assign(Token* name, int slot, Value value)
 {
-    Environment* environment = this;
-    for (int i = 0; i < distance; i++) {
-        environment = environment->enclosing;
+    if ((*defined)[slot]) {
+        slots[slot] = value;
+        return;
     }
 
-    return environment;
+    throw new RuntimeError(name, "Undefined variable '" + name->lexeme() + "'.");
 }
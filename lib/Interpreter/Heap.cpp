@@ -0,0 +1,176 @@
+#include "./../../include/Interpreter/Heap.h"
+
+Heap::Heap()
+{
+    this->growthFactor = 2.0;
+    this->minimumThreshold = 1024 * 1024;
+    this->reportStats = false;
+
+    this->objects = nullptr;
+    this->grayStack = new std::vector<HeapObject*>();
+    this->tempRoots = new std::vector<Value>();
+    this->rootProvider = nullptr;
+
+    this->epoch = 0;
+    this->bytesAllocated = 0;
+    this->nextCollection = minimumThreshold;
+
+    this->collections = 0;
+    this->objectsFreed = 0;
+    this->bytesReclaimed = 0;
+    this->totalPauseMs = 0;
+    this->maxPauseMs = 0;
+}
+
+void Heap::setRootProvider(GcRootProvider* rootProvider)
+{
+    this->rootProvider = rootProvider;
+}
+
+void Heap::trackObject(HeapObject* object)
+{
+    if (bytesAllocated > nextCollection) {
+        collect();
+    }
+
+    object->trackedBytes = object->size();
+    bytesAllocated += object->trackedBytes;
+
+    object->next = objects;
+    objects = object;
+}
+
+void Heap::grew(HeapObject* object)
+{
+    // Untracked objects live for the whole session and are never counted
+    if (object->trackedBytes == 0) {
+        return;
+    }
+
+    std::size_t bytes = object->size();
+
+    bytesAllocated = bytesAllocated - object->trackedBytes + bytes;
+    object->trackedBytes = bytes;
+}
+
+void Heap::pushRoot(Value value)
+{
+    tempRoots->push_back(value);
+}
+
+void Heap::popRoots(std::size_t count)
+{
+    tempRoots->resize(tempRoots->size() - count);
+}
+
+void Heap::resetRoots()
+{
+    tempRoots->clear();
+}
+
+void Heap::markValue(Value value)
+{
+    if (value.isObject()) {
+        markObject(value.asObject());
+    }
+}
+
+void Heap::markObject(HeapObject* object)
+{
+    if (object == nullptr || object->markEpoch == epoch) {
+        return;
+    }
+
+    object->markEpoch = epoch;
+
+    // Children are traced later from the gray stack
+    // instead of recursing, so deep object graphs cant overflow the C++ stack
+    grayStack->push_back(object);
+}
+
+void Heap::collect()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // A new epoch makes every object unmarked without touching them
+    epoch++;
+
+    for (Value value: *tempRoots) {
+        markValue(value);
+    }
+
+    if (rootProvider != nullptr) {
+        rootProvider->markRoots(this);
+    }
+
+    traceReferences();
+    sweep();
+
+    nextCollection = bytesAllocated * growthFactor;
+    if (nextCollection < minimumThreshold) {
+        nextCollection = minimumThreshold;
+    }
+
+    std::chrono::duration<double, std::milli> pause = 
+        std::chrono::steady_clock::now() - start;
+
+    collections++;
+    totalPauseMs += pause.count();
+    if (pause.count() > maxPauseMs) {
+        maxPauseMs = pause.count();
+    }
+}
+
+void Heap::traceReferences()
+{
+    while (!grayStack->empty()) {
+        HeapObject* object = grayStack->back();
+        grayStack->pop_back();
+
+        object->trace(this);
+
+        // Catches growth no caller reported, so live bytes are exact after sweeping
+        grew(object);
+    }
+}
+
+void Heap::sweep()
+{
+    HeapObject* previous = nullptr;
+    HeapObject* object = objects;
+
+    while (object != nullptr) {
+        if (object->markEpoch == epoch) {
+            previous = object;
+            object = object->next;
+            continue;
+        }
+
+        // Unreached object, unlinking and freeing it
+        HeapObject* unreached = object;
+        object = object->next;
+
+        if (previous != nullptr) {
+            previous->next = object;
+        } else {
+            objects = object;
+        }
+
+        bytesAllocated -= unreached->trackedBytes;
+        bytesReclaimed += unreached->trackedBytes;
+        objectsFreed++;
+
+        delete unreached;
+    }
+}
+
+void Heap::printStats(std::ostream& os)
+{
+    os << "[gc] collections: " << collections << std::endl;
+    os << "[gc] total pause: " << totalPauseMs << " ms"
+       << " (max " << maxPauseMs << " ms, avg " 
+       << (collections > 0 ? totalPauseMs / collections : 0) << " ms)" << std::endl;
+    os << "[gc] bytes reclaimed: " << bytesReclaimed << std::endl;
+    os << "[gc] objects freed: " << objectsFreed << std::endl;
+    os << "[gc] live bytes: " << bytesAllocated << std::endl;
+}
@@ -0,0 +1,18 @@
+#include "./../../include/Interpreter/HeapObject.h"
+
+HeapObject::HeapObject()
+{
+    this->markEpoch = 0;
+    this->trackedBytes = 0;
+    this->next = nullptr;
+}
+
+HeapObject::~HeapObject()
+{
+
+}
+
+void HeapObject::trace(Heap* heap)
+{
+    // Leaf objects do not reference anything
+}
@@ -3,64 +3,149 @@
 Interpreter::Interpreter()
 {
     this->globals = new Environment();
-    this->environment = this->globals;
 
-    this->locals = new std::unordered_map<Expr::Expr*, int>();
+    this->stack = new Value[STACK_MAX];
+    this->stackTop = this->stack;
+    this->frame = this->stack;
+    this->closure = nullptr;
+
+    this->heap = new Heap();
+    this->heap->setRootProvider(this);
+
+    // Always reached from markRoots, tracked so its slots are counted as they grow
+    this->heap->track(this->globals);
+    this->callers = new std::vector<LoxFunction*>();
+    this->tailFunction = nullptr;
+    this->tailHasReceiver = false;
+    this->tailArguments = new std::vector<Value>();
+    this->jit = new Jit(this->globals);
+
+    setupNativeFunctions();
 }
 
 void Interpreter::setupNativeFunctions()
 {
     this->globals->define(
-        new std::string("clock"),
-        static_cast<void*>(new Clock())
+        StringTable::global()->intern("clock"),
+        Value::fromObject(new Clock())
+    );
+
+    this->globals->define(
+        StringTable::global()->intern("flush"),
+        Value::fromObject(new Flush())
     );
 }
 
-std::string* Interpreter::visitLiteralExpr(Expr::Literal* expr)
+Value Interpreter::visitLiteralExpr(Expr::Literal* expr)
 {
     return expr->value;
 }
 
-std::string* Interpreter::visitGroupingExpr(Expr::Grouping* expr)
+Value Interpreter::visitGroupingExpr(Expr::Grouping* expr)
 {
     return evaluate(expr->expression);
 }
 
-std::string* Interpreter::visitUnaryExpr(Expr::Unary* expr)
+Value Interpreter::visitUnaryExpr(Expr::Unary* expr)
 {
-    std::string* right = evaluate(expr->right);
+    Value right = evaluate(expr->right);
+
+    // Specialized nodes skip the operator switch while their guard holds
+    switch (expr->specialization) {
+        case Expr::UNARY_NEGATE_NUMBER:
+            if (right.isNumber()) {
+                return Value::fromNumber(-right.asNumber());
+            }
+
+            expr->specialization = Expr::UNARY_GENERIC;
+            break;
+
+        case Expr::UNARY_NOT_BOOL:
+            if (right.isBool()) {
+                return Value::fromBool(!right.asBool());
+            }
+
+            expr->specialization = Expr::UNARY_GENERIC;
+            break;
+
+        case Expr::UNARY_UNSPECIALIZED:
+            specialize(expr, right);
+            break;
+
+        default:
+            break;
+    }
+
+    return unaryOperation(expr, right);
+}
 
+Value Interpreter::unaryOperation(Expr::Unary* expr, Value right)
+{
     // This is what that makes a language dynamically typed
     switch (expr->operator_->type) {
         case TokenType::MINUS:
             checkNumberOperand(expr->operator_, right);
-            *right = "-" + *right;
-            return right;
+            return Value::fromNumber(-right.asNumber());
 
         case TokenType::BANG:
-            
-            return right;
+            return Value::fromBool(!isTruthy(right));
 
         default:
-            return nullptr;
-            break;
+            return Value();
     }
 }
 
-std::string* Interpreter::visitLogicalExpr(Expr::Logical* expr)
+void Interpreter::specialize(Expr::Unary* expr, Value right)
+{
+    expr->specialization = Expr::UNARY_GENERIC;
+
+    if (expr->operator_->type == TokenType::MINUS && right.isNumber()) {
+        expr->specialization = Expr::UNARY_NEGATE_NUMBER;
+    } else if (expr->operator_->type == TokenType::BANG && right.isBool()) {
+        expr->specialization = Expr::UNARY_NOT_BOOL;
+    }
+}
+
+Value Interpreter::visitLogicalExpr(Expr::Logical* expr)
 {
     // Calculated in in-order to support short circuit evaluation
 
-    std::string* left = evaluate(expr->left);
+    Value left = evaluate(expr->left);
+
+    // Boolean left operand decides short circuiting by itself
+    switch (expr->specialization) {
+        case Expr::LOGICAL_AND_BOOL:
+            if (left.isBool()) {
+                return left.asBool() ? evaluate(expr->right) : left;
+            }
+
+            expr->specialization = Expr::LOGICAL_GENERIC;
+            break;
+
+        case Expr::LOGICAL_OR_BOOL:
+            if (left.isBool()) {
+                return left.asBool() ? left : evaluate(expr->right);
+            }
+
+            expr->specialization = Expr::LOGICAL_GENERIC;
+            break;
+
+        case Expr::LOGICAL_UNSPECIALIZED:
+            specialize(expr, left);
+            break;
+
+        default:
+            break;
+    }
 
     // Checking if we can short circuit the logical expression
     // Based on the evaluated left value
     if (expr->operator_->type == TokenType::OR) {
-        if (*isTruthy(left) != "false") {
+        if (isTruthy(left)) {
             return left;
         } 
     } else {
-        if (*isTruthy(left) == "false") {
+        if (!isTruthy(left)) {
             return left;
         }
     }
@@ -68,166 +153,511 @@ std::string* Interpreter::visitLogicalExpr(Expr::Logical* expr)
     return evaluate(expr->right);
 }
 
-std::string* Interpreter::visitBinaryExpr(Expr::Binary* expr)
+void Interpreter::specialize(Expr::Logical* expr, Value left)
+{
+    expr->specialization = Expr::LOGICAL_GENERIC;
+
+    if (left.isBool()) {
+        expr->specialization = expr->operator_->type == TokenType::OR
+            ? Expr::LOGICAL_OR_BOOL
+            : Expr::LOGICAL_AND_BOOL;
+    }
+}
+
+Value Interpreter::visitBinaryExpr(Expr::Binary* expr)
+{
+    // Evaluates the nested additions itself
+    if (expr->specialization == Expr::BINARY_CONCATENATE) {
+        return concatenateChain(expr);
+    }
+
+    Value left = evaluate(expr->left);
+
+    // Numbers need no rooting, the right operand is evaluated right away
+    // Guard failing on either operand makes the node generic
+    #define NUMBER_OPERATION(kind, valueType, op) \
+        case kind: \
+            if (left.isNumber()) { \
+                Value right = evaluate(expr->right); \
+                if (right.isNumber()) { \
+                    return Value::valueType(left.asNumber() op right.asNumber()); \
+                } \
+                expr->specialization = Expr::BINARY_GENERIC; \
+                return binaryOperation(expr, left, right); \
+            } \
+            expr->specialization = Expr::BINARY_GENERIC; \
+            break;
+
+    switch (expr->specialization) {
+        NUMBER_OPERATION(Expr::BINARY_ADD_NUMBERS, fromNumber, +)
+        NUMBER_OPERATION(Expr::BINARY_SUBTRACT_NUMBERS, fromNumber, -)
+        NUMBER_OPERATION(Expr::BINARY_MULTIPLY_NUMBERS, fromNumber, *)
+        NUMBER_OPERATION(Expr::BINARY_DIVIDE_NUMBERS, fromNumber, /)
+        NUMBER_OPERATION(Expr::BINARY_GREATER_NUMBERS, fromBool, >)
+        NUMBER_OPERATION(Expr::BINARY_GREATER_EQUAL_NUMBERS, fromBool, >=)
+        NUMBER_OPERATION(Expr::BINARY_LESS_NUMBERS, fromBool, <)
+        NUMBER_OPERATION(Expr::BINARY_LESS_EQUAL_NUMBERS, fromBool, <=)
+        NUMBER_OPERATION(Expr::BINARY_EQUAL_NUMBERS, fromBool, ==)
+        NUMBER_OPERATION(Expr::BINARY_NOT_EQUAL_NUMBERS, fromBool, !=)
+
+        case Expr::BINARY_ADD_STRINGS:
+            if (left.isString()) {
+                heap->pushRoot(left);
+                Value right = evaluate(expr->right);
+
+                if (right.isString()) {
+                    heap->pushRoot(right);
+                    LoxString* result = LoxString::concatenate(heap, left.asString(), right.asString());
+                    heap->popRoots(2);
+
+                    return Value::fromObject(result);
+                }
+
+                heap->popRoots(1);
+                expr->specialization = Expr::BINARY_GENERIC;
+                return binaryOperation(expr, left, right);
+            }
+
+            expr->specialization = Expr::BINARY_GENERIC;
+            break;
+
+        default:
+            break;
+    }
+
+    #undef NUMBER_OPERATION
+
+    // Right operand can allocate and trigger a collection
+    heap->pushRoot(left);
+    Value right = evaluate(expr->right);
+    heap->popRoots(1);
+
+    if (expr->specialization == Expr::BINARY_UNSPECIALIZED) {
+        specialize(expr, left, right);
+    }
+
+    return binaryOperation(expr, left, right);
+}
+
+void Interpreter::specialize(Expr::Binary* expr, Value left, Value right)
+{
+    expr->specialization = Expr::BINARY_GENERIC;
+
+    if (left.isNumber() && right.isNumber()) {
+        switch (expr->operator_->type) {
+            case TokenType::PLUS: expr->specialization = Expr::BINARY_ADD_NUMBERS; break;
+            case TokenType::MINUS: expr->specialization = Expr::BINARY_SUBTRACT_NUMBERS; break;
+            case TokenType::STAR: expr->specialization = Expr::BINARY_MULTIPLY_NUMBERS; break;
+            case TokenType::SLASH: expr->specialization = Expr::BINARY_DIVIDE_NUMBERS; break;
+            case TokenType::GREATER: expr->specialization = Expr::BINARY_GREATER_NUMBERS; break;
+            case TokenType::GREATER_EQUAL: expr->specialization = Expr::BINARY_GREATER_EQUAL_NUMBERS; break;
+            case TokenType::LESS: expr->specialization = Expr::BINARY_LESS_NUMBERS; break;
+            case TokenType::LESS_EQUAL: expr->specialization = Expr::BINARY_LESS_EQUAL_NUMBERS; break;
+            case TokenType::EQUAL_EQUAL: expr->specialization = Expr::BINARY_EQUAL_NUMBERS; break;
+            case TokenType::BANG_EQUAL: expr->specialization = Expr::BINARY_NOT_EQUAL_NUMBERS; break;
+            default: break;
+        }
+    } else if ((left.isString() || right.isString()) && expr->operator_->type == TokenType::PLUS) {
+        Expr::Binary* addition = dynamic_cast<Expr::Binary*>(expr->left);
+
+        if (addition != nullptr && addition->operator_->type == TokenType::PLUS) {
+            expr->specialization = Expr::BINARY_CONCATENATE;
+        } else if (left.isString() && right.isString()) {
+            expr->specialization = Expr::BINARY_ADD_STRINGS;
+        }
+    }
+}
+
+Value Interpreter::concatenate(Token* operator_, Value left, Value right)
+{
+    heap->pushRoot(left);
+    heap->pushRoot(right);
+
+    Value result;
+    if (left.isString() && right.isString()) {
+        result = Value::fromObject(LoxString::concatenate(heap, left.asString(), right.asString()));
+    } else {
+        std::string builder;
+        Value sum = left;
+        addOperand(operator_, &sum, &builder, right);
+        result = finishAddition(sum, &builder);
+    }
+
+    heap->popRoots(2);
+
+    return result;
+}
+
+Value Interpreter::concatenateChain(Expr::Binary* expr)
+{
+    std::string builder;
+    Value sum = addChainOperands(expr, &builder);
+
+    if (!sum.isString()) {
+        return sum;
+    }
+
+    heap->pushRoot(sum);
+    Value result = finishAddition(sum, &builder);
+    heap->popRoots(1);
+
+    return result;
+}
+
+Value Interpreter::addChainOperands(Expr::Binary* expr, std::string* builder)
+{
+    // Innermost addition runs first, like when the nodes are evaluated one at a time
+    Expr::Binary* addition = dynamic_cast<Expr::Binary*>(expr->left);
+
+    Value sum = addition != nullptr && addition->operator_->type == TokenType::PLUS
+        ? addChainOperands(addition, builder)
+        : evaluate(expr->left);
+
+    // Right operand can allocate and trigger a collection
+    heap->pushRoot(sum);
+    Value operand = evaluate(expr->right);
+    heap->popRoots(1);
+
+    addOperand(expr->operator_, &sum, builder, operand);
+
+    return sum;
+}
+
+void Interpreter::addOperand(Token* operator_, Value* sum, std::string* builder, Value operand)
+{
+    if (sum->isString()) {
+        if (operand.isString()) {
+            builder->append(operand.asString()->text());
+        } else if (operand.isNumber()) {
+            // Numbers are formatted straight into the builder
+            char number[NumberFormatter::MAX_LENGTH];
+            builder->append(number, NumberFormatter::format(operand.asNumber(), number));
+        } else {
+            builder->append(stringify(operand));
+        }
+
+        return;
+    }
+
+    if (sum->isNumber() && operand.isNumber()) {
+        *sum = Value::fromNumber(sum->asNumber() + operand.asNumber());
+        return;
+    }
+
+    if (operand.isString()) {
+        // The whole text is in the builder, after an empty string
+        *builder = stringify(*sum);
+        builder->append(operand.asString()->text());
+        *sum = Value::fromObject(StringTable::global()->intern(""));
+        return;
+    }
+
+    throw new RuntimeError(operator_, 
+        "Operands must be two numbers or two strings."
+    );
+}
+
+Value Interpreter::finishAddition(Value sum, std::string* builder)
 {
-    std::string* left = evaluate(expr->left);
-    std::string* right = evaluate(expr->right);
+    if (!sum.isString() || builder->empty()) {
+        return sum;
+    }
 
+    return Value::fromObject(LoxString::concatenate(heap, sum.asString(), *builder));
+}
+
+Value Interpreter::binaryOperation(Expr::Binary* expr, Value left, Value right)
+{
     switch (expr->operator_->type) {
         case TokenType::MINUS:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) - 
-                string_to_double(right)
-            ));
+            return Value::fromNumber(left.asNumber() - right.asNumber());
 
         case TokenType::SLASH:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) / 
-                string_to_double(right)
-            ));
+            return Value::fromNumber(left.asNumber() / right.asNumber());
 
         case TokenType::STAR:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) * 
-                string_to_double(right)
-            ));
+            return Value::fromNumber(left.asNumber() * right.asNumber());
 
         // Handles string concatenation and double addtion
         // If anyone one of operands is string then,
         // returns their concatenation
         case TokenType::PLUS:
-            if (!isDouble(left) || !isDouble(right)) {
-                return new std::string(*left + *right);
+            if (left.isNumber() && right.isNumber()) {
+                return Value::fromNumber(left.asNumber() + right.asNumber());
             }
 
-            return new std::string(std::to_string(
-                string_to_double(left) +
-                string_to_double(right)
-            ));
+            return concatenate(expr->operator_, left, right);
 
         case TokenType::GREATER:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) >
-                string_to_double(right)
-            ));
+            return Value::fromBool(left.asNumber() > right.asNumber());
 
         case TokenType::GREATER_EQUAL:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) >=
-                string_to_double(right)
-            ));
+            return Value::fromBool(left.asNumber() >= right.asNumber());
 
         case TokenType::LESS:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) <
-                string_to_double(right)
-            ));
+            return Value::fromBool(left.asNumber() < right.asNumber());
 
         case TokenType::LESS_EQUAL:
             checkNumberOperands(expr->operator_, left, right);
-            return new std::string(std::to_string(
-                string_to_double(left) <=
-                string_to_double(right)
-            ));
+            return Value::fromBool(left.asNumber() <= right.asNumber());
 
         case TokenType::BANG_EQUAL:
-            return new std::string(std::to_string(
-                !isEqual(left, right))
-            );
+            return Value::fromBool(!isEqual(left, right));
 
         case TokenType::EQUAL_EQUAL:
-            return new std::string(std::to_string(
-                isEqual(left, right))
-            );
+            return Value::fromBool(isEqual(left, right));
 
         default:
-            return nullptr;
+            return Value();
     }
 }
 
-std::string* Interpreter::visitCallExpr(Expr::Call* expr)
+Value Interpreter::visitCallExpr(Expr::Call* expr)
 {
-    // MAY NEED TO FIX THIS IF FUNCTIONS DOESNT WORK
-    void* callee = static_cast<void*>(evaluate(expr->callee));
+    if (expr->method != nullptr) {
+        return invokeMethod(expr);
+    }
 
-    // Contains evaluated arguements
-    std::vector<std::string*>* arguements = new std::vector<std::string*>();
+    return call(expr, evaluate(expr->callee), nullptr);
+}
 
-    for (Expr::Expr* arguement: *(expr->arguments)) {
-        arguements->push_back(evaluate(arguement));
-    }
-
-    // No need to dynamic cast
-    // Since Environment stores the function as void*
-    if (LoxCallable* function = static_cast<LoxCallable*>(callee)) {
-        // Handling Errors before calling a function
-        if (arguements->size() != function->arity()) {
-            throw new RuntimeError(
-                expr->paren,
-                "Exprected " + std::to_string(function->arity()) + " arguements but got " +
-                std::to_string(arguements->size()) + "."
-            );
+Value Interpreter::invokeMethod(Expr::Call* expr)
+{
+    Value object = evaluate(expr->method->object);
+    Value callee;
+
+    if (methodCallee(expr, object, &callee)) {
+        return call(expr, callee, &object);
+    }
+
+    return call(expr, callee, nullptr);
+}
+
+bool Interpreter::methodCallee(Expr::Call* expr, Value object, Value* callee)
+{
+    Expr::Get* get = expr->method;
+
+    if (!object.isInstance()) {
+        throw new RuntimeError(get->name,
+            "Only instances have properties."
+        );
+    }
+
+    LoxInstance* instance = object.asInstance();
+
+    // Cache hit means the shape has no field shadowing the method
+    for (int i = 0; i < expr->methodCacheCount; i++) {
+        if (expr->methodCache[i].shapeId == instance->shape->id) {
+            *callee = Value::fromObject(expr->methodCache[i].method);
+            return true;
         }
-        // Calling the Function by its name and evaluated arguements
-        return function->call(this, arguements);
+    }
 
-    } else {
-        throw new RuntimeError(expr->paren, "Can only call functions and classes.");
+    // Fields shadow methods, calling a field holding a function
+    if (instance->getField(get->name->interned, callee)) {
+        return false;
+    }
+
+    *callee = Value::fromObject(findMethod(expr, instance));
+    return true;
+}
+
+LoxFunction* Interpreter::findMethod(Expr::Call* expr, LoxInstance* instance)
+{
+    Token* name = expr->method->name;
+    LoxObject* method = instance->klass->findMethod(name->interned);
+
+    if (method == nullptr) {
+        throw new RuntimeError(name,
+            "Undefined property '" + name->lexeme() + "'."
+        );
+    }
+
+    // Shapes belong to a single class and fix the set of fields,
+    // so the same shape always finds the same method.
+    // Megamorphic sites, having seen too many shapes, stop caching
+    if (expr->methodCacheCount < Expr::METHOD_CACHE_SIZE) {
+        Expr::MethodCacheEntry& entry = expr->methodCache[expr->methodCacheCount++];
+        entry.shapeId = instance->shape->id;
+        entry.method = method;
     }
 
+    return static_cast<LoxFunction*>(method);
 }
 
-std::string* Interpreter::visitAssignExpr(Expr::Assign* expr)
+Value Interpreter::call(Expr::Call* expr, Value callee, Value* receiver)
+{
+    heap->pushRoot(callee);
+
+    // Receiver and arguements are pushed on the stack, where they are rooted
+    // and already in place as the first slots of a Lox function's frame
+    Value* base = stackTop;
+
+    if (receiver != nullptr) {
+        pushArgument(expr->paren, *receiver);
+        receiver = base;
+    }
+
+    Value* arguements = stackTop;
+
+    for (Expr::Expr* arguement: *(expr->arguments)) {
+        pushArgument(expr->paren, evaluate(arguement));
+    }
+
+    ArgumentSpan span(arguements, stackTop - arguements);
+
+    Value result;
+    if (!expr->tailCall || !scheduleTailCall(callee, receiver, span)) {
+        result = callValue(expr->paren, callee, receiver, span);
+    }
+
+    stackTop = base;
+    heap->popRoots(1);
+
+    return result;
+}
+
+void Interpreter::pushArgument(Token* paren, Value value)
+{
+    if (stackTop == stack + STACK_MAX) {
+        throw new RuntimeError(paren, "Stack overflow.");
+    }
+
+    *stackTop++ = value;
+}
+
+bool Interpreter::scheduleTailCall(Value callee, Value* receiver, ArgumentSpan arguements)
+{
+    // Classes, natives and calls failing the arity check are called as usual
+    if (!callee.isObjectType(OBJ_FUNCTION)) {
+        return false;
+    }
+
+    LoxFunction* function = static_cast<LoxFunction*>(callee.asObject());
+
+    if (function->isInitializer || arguements.size() != function->arity()) {
+        return false;
+    }
+
+    tailFunction = function;
+    tailHasReceiver = receiver != nullptr;
+    if (receiver != nullptr) {
+        tailReceiver = *receiver;
+    }
+
+    tailArguments->assign(arguements.begin(), arguements.end());
+
+    return true;
+}
+
+Stmt::Completion Interpreter::returnCompletion()
+{
+    return tailFunction != nullptr ? Stmt::COMPLETION_TAIL_CALL : Stmt::COMPLETION_RETURN;
+}
+
+Value Interpreter::callValue(Token* paren, Value callee, Value* receiver, ArgumentSpan arguements)
+{
+    // Only functions and classes carry the callable object types
+    if (!callee.isCallable()) {
+        throw new RuntimeError(paren, "Can only call functions and classes.");
+    }
+
+    LoxCallable* function = callee.asCallable();
+
+    // Handling Errors before calling a function
+    if (arguements.size() != function->arity()) {
+        throw new RuntimeError(
+            paren,
+            "Exprected " + std::to_string(function->arity()) + " arguements but got " +
+            std::to_string(arguements.size()) + "."
+        );
+    }
+
+    // Calling the Function by its name and evaluated arguements
+    if (receiver != nullptr) {
+        return callFunction(static_cast<LoxFunction*>(function), receiver, arguements);
+    }
+
+    return function->call(this, arguements);
+}
+
+Value Interpreter::visitAssignExpr(Expr::Assign* expr)
 {
     // Resolving method similar to Variable Expression
     // This will require to update the variable values
-    std::string* value = evaluate(expr->value);
+    Value value = evaluate(expr->value);
 
-    if (locals->find(expr) != locals->end()) {
-        environment->assignAt(
-            locals->at(expr),
-            expr->name,
-            static_cast<void*>(value)
-        );
-    } else {
-        environment->assign(
+    if (expr->kind == Expr::VARIABLE_GLOBAL) {
+        if (expr->slot == Expr::UNCACHED_SLOT) {
+            expr->slot = globals->globalSlot(expr->name->interned);
+        }
+
+        globals->assign(
             expr->name, 
-            static_cast<void*>(value)
+            expr->slot,
+            value
         );
+    } else {
+        assignLocal(expr->kind, expr->slot, value);
     }
     
     return value;
 }
 
-std::string* Interpreter::visitGetExpr(Expr::Get* expr)
+Value Interpreter::visitGetExpr(Expr::Get* expr)
 {
-    void* object = static_cast<void*>(evaluate(expr->object));
+    return getProperty(expr->name, evaluate(expr->object));
+}
 
+Value Interpreter::getProperty(Token* name, Value object)
+{
     // If expression is not instance type, then error is throw
-    if (LoxInstance* instance = static_cast<LoxInstance*>(object)) {
-        return static_cast<std::string*>(instance->get(expr->name));
+    if (!object.isInstance()) {
+        throw new RuntimeError(name,
+            "Only instances have properties."
+        );
     }
 
-    throw new RuntimeError(expr->name,
-        "Only instances have properties."
+    Value field;
+    if (object.asInstance()->getField(name->interned, &field)) {
+        return field;
+    }
+
+    // Method read without calling it, bound to the instance for later calls
+    LoxObject* method = object.asInstance()->klass->findMethod(name->interned);
+
+    if (method != nullptr) {
+        heap->pushRoot(object);
+        LoxBoundMethod* bound = heap->track(new LoxBoundMethod(object, method));
+        heap->popRoots(1);
+
+        return Value::fromObject(bound);
+    }
+
+    // If the property does not exist then a runtime error is throw
+    throw new RuntimeError(name,
+        "Undefined property '" + name->lexeme() + "'."
     );
 }
 
-std::string* Interpreter::visitSetExpr(Expr::Set* expr)
+Value Interpreter::visitSetExpr(Expr::Set* expr)
 {
-    void* object = static_cast<void*>(expr->object);
+    Value object = evaluate(expr->object);
 
-    if (LoxInstance* set = static_cast<LoxInstance*>(object)) {
+    if (object.isInstance()) {
         // Evaluating the object whole property is being set
-        std::string* value = evaluate(expr->value);
+        heap->pushRoot(object);
+        Value value = evaluate(expr->value);
+        heap->popRoots(1);
 
-        set->set(expr->name, static_cast<void*>(value));
+        object.asInstance()->setField(expr->name->interned, value);
+        heap->grew(object.asInstance());
 
         return value;
     } 
@@ -237,246 +667,490 @@ std::string* Interpreter::visitSetExpr(Expr::Set* expr)
     );
 }
 
-std::string* Interpreter::visitVariableExpr(Expr::Variable* expr)
+Value Interpreter::visitThisExpr(Expr::This* expr)
 {
-    // return static_cast<std::string*>(environment->get(expr->name));
+    return getLocal(expr->kind, expr->slot);
+}
 
-    return static_cast<std::string*>(lookUpVariable(expr->name, expr));
+Value Interpreter::visitVariableExpr(Expr::Variable* expr)
+{
+    return lookUpVariable(expr);
 }
 
-void* Interpreter::visitExpressionStmt(Stmt::Expression* stmt)
+Stmt::Completion Interpreter::visitExpressionStmt(Stmt::Expression* stmt)
 {
     evaluate(stmt->expression);
     
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitClassStmt(Stmt::Class* stmt)
+Stmt::Completion Interpreter::visitClassStmt(Stmt::Class* stmt)
 {
-    // Seperate Define and Assign because of Global Classes
-    // Which are not handled by Resolver
-    environment->define(stmt->name->lexeme, nullptr);
-    LoxClass* klass = new LoxClass(stmt->name->lexeme);
-
-    // The two stage variable binding process allows references to the class 
-    // inside its own methods
-    environment->assign(stmt->name, klass);
+    defineClass(stmt, nullptr);
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitPrintStmt(Stmt::Print* stmt)
+Stmt::Completion Interpreter::visitPrintStmt(Stmt::Print* stmt)
 {
-    std::string* value = evaluate(stmt->expression);
+    Value value = evaluate(stmt->expression);
     
-    std::cout << stringify(value) << std::endl;
+    Lox::output->print(value);
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitVarStmt(Stmt::Var* stmt)
+Stmt::Completion Interpreter::visitVarStmt(Stmt::Var* stmt)
 {
-    std::string* value = nullptr;
+    Value value;
 
     if (stmt->initializer != nullptr) {
         value = evaluate(stmt->initializer);
     }
 
-    environment->define(
-        stmt->name->lexeme, 
-        static_cast<void*>(value)
-    );
+    define(stmt->name, stmt->kind, value);
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitBlockStmt(Stmt::Block* stmt)
+Stmt::Completion Interpreter::visitBlockStmt(Stmt::Block* stmt)
 {
-    executeBlock(stmt->statements, new Environment(environment));
+    if (stmt->localCount == 0) {
+        return executeStatements(stmt->statements);
+    }
 
-    return nullptr;
+    return executeBlock(stmt->statements);
 }
 
-void* Interpreter::visitIfStmt(Stmt::If* stmt)
+Stmt::Completion Interpreter::visitIfStmt(Stmt::If* stmt)
 {
-    std::string evaluatedCondition = *isTruthy(evaluate(stmt->condition));
-    if (
-        evaluatedCondition != "false" && 
-        evaluatedCondition != "0"
-    ) {
-        execute(stmt->thenBranch);
+    if (isTruthy(evaluate(stmt->condition))) {
+        return execute(stmt->thenBranch);
     } else if (stmt->elseBranch != nullptr) {
-        execute(stmt->elseBranch);
+        return execute(stmt->elseBranch);
     }
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitFunctionStmt(Stmt::Function* stmt)
+Stmt::Completion Interpreter::visitFunctionStmt(Stmt::Function* stmt)
 {
     // Convertin
     // Compile Time representation of function
     // Runtime representation
-    // The below env is active when function is declared 
-    // Not when the function is called
-    LoxFunction* function = new LoxFunction(stmt, environment);
-    environment->define(stmt->name->lexeme, function);
+    defineFunction(stmt, nullptr);
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitWhileStmt(Stmt::While* stmt)
+Stmt::Completion Interpreter::visitWhileStmt(Stmt::While* stmt)
 {
-    while (true) {
-        std::string condition = *isTruthy(evaluate(stmt->condition));
-        if (condition == "false" || condition == "0") {
-            break;
-        }
+    while (isTruthy(evaluate(stmt->condition))) {
+        Stmt::Completion completion = execute(stmt->body);
 
-        execute(stmt->body);
+        // A return inside the loop body leaves the loop too
+        if (completion != Stmt::COMPLETION_NORMAL) {
+            return completion;
+        }
     }
 
-    return nullptr;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-void* Interpreter::visitReturnStmt(Stmt::Return* stmt)
+Stmt::Completion Interpreter::visitReturnStmt(Stmt::Return* stmt)
 {
-    void* value = nullptr;
+    returnValue = Value();
 
     if (stmt->value != nullptr) {
-        value = static_cast<void*>(evaluate(stmt->value));
+        returnValue = evaluate(stmt->value);
     }
-    
-    throw new Runtime::Return(value);
+
+    // Enclosing blocks stop executing and the call picks up returnValue
+    return returnCompletion();
 }
 
-void Interpreter::interpret(std::vector<Stmt::Stmt*>* statements)
+void Interpreter::interpret(NodeList<Stmt::Stmt*>* statements)
 {
     try {
         for (Stmt::Stmt* statement: *statements) {
             execute(statement);
         }
     } catch (RuntimeError* error) {
-        Lox::runtimeError(*error);
+        recover(error);
     }
 }
 
-void* Interpreter::lookUpVariable(Token* name, Expr::Expr* expr)
+void Interpreter::interpret(CompiledBlock* program)
 {
-    // If variable isnt present in locals
+    try {
+        for (CompiledStmt& statement: program->statements) {
+            statement();
+        }
+    } catch (RuntimeError* error) {
+        recover(error);
+    }
+}
+
+void Interpreter::recover(RuntimeError* error)
+{
+    Lox::runtimeError(*error);
+    delete error;
+
+    // Every scope and evaluation in progress was abandoned by the error
+    stackTop = stack;
+    frame = stack;
+    closure = nullptr;
+    callers->clear();
+    tailFunction = nullptr;
+    heap->resetRoots();
+}
+
+Value Interpreter::lookUpVariable(Expr::Variable* expr)
+{
+    // If variable wasnt resolved to a local scope
     // It is assumed in globals variables
     // Which throws runtime error if undefined variable accessed
-    if (locals->find(expr) != locals->end()) {
-        // Found a local variable
-        return environment->getAt(locals->at(expr), *name->lexeme);
-    } else {
-        return globals->get(name);
+    if (expr->kind == Expr::VARIABLE_GLOBAL) {
+        // Caching the table index so later executions skip hashing the name
+        if (expr->slot == Expr::UNCACHED_SLOT) {
+            expr->slot = globals->globalSlot(expr->name->interned);
+        }
+
+        return globals->get(expr->name, expr->slot);
     }
+
+    // Found a local variable
+    return getLocal(expr->kind, expr->slot);
 }
 
+Value Interpreter::getLocal(Expr::VariableKind kind, int slot)
+{
+    switch (kind) {
+        case Expr::VARIABLE_LOCAL:
+            return frame[slot];
+
+        case Expr::VARIABLE_CELL:
+            return static_cast<LoxUpvalue*>(frame[slot].asObject())->value;
 
-std::string Interpreter::stringify(std::string* object)
+        default:
+            return closure->upvalues[slot]->value;
+    }
+}
+
+void Interpreter::assignLocal(Expr::VariableKind kind, int slot, Value value)
 {
-    if (object == nullptr) {
-        return "nil";
+    switch (kind) {
+        case Expr::VARIABLE_LOCAL:
+            frame[slot] = value;
+            break;
+
+        case Expr::VARIABLE_CELL:
+            static_cast<LoxUpvalue*>(frame[slot].asObject())->value = value;
+            break;
+
+        default:
+            closure->upvalues[slot]->value = value;
+            break;
     }
-    
-    return *object;
 }
 
-void Interpreter::execute(Stmt::Stmt* stmt)
+void Interpreter::defineFunction(Stmt::Function* declaration, CompiledBlock* compiled)
 {
-    stmt->accept(this);
+    LoxUpvalue* cell = declareCell(declaration->kind);
+    LoxFunction* function = makeFunction(declaration, false, compiled);
+
+    if (cell != nullptr) {
+        cell->value = Value::fromObject(function);
+        return;
+    }
+
+    heap->pushRoot(Value::fromObject(function));
+    define(declaration->name, declaration->kind, Value::fromObject(function));
+    heap->popRoots(1);
 }
 
-void Interpreter::executeBlock(std::vector<Stmt::Stmt*>* statments, Environment* environment)
+void Interpreter::defineClass(Stmt::Class* stmt, std::vector<CompiledBlock*>* bodies)
 {
-    Environment* previous = this->environment;
+    LoxUpvalue* cell = declareCell(stmt->kind);
 
-    try {
-        this->environment = environment;
+    LoxClass* klass = heap->track(new LoxClass(stmt->name->lexeme()));
+    heap->pushRoot(Value::fromObject(klass));
 
-        for (Stmt::Stmt* statement: *statments) {
-            execute(statement);
+    // Methods capture variables of the scope the class is declared in
+    for (unsigned int i = 0; i < stmt->methods->size(); i++) {
+        Stmt::Function* method = stmt->methods->at(i);
+        LoxString* name = method->name->interned;
+        CompiledBlock* body = bodies != nullptr ? bodies->at(i) : nullptr;
+
+        (*klass->methods)[name] = makeFunction(method, name == LoxClass::initializerName(), body);
+    }
+
+    if (cell != nullptr) {
+        cell->value = Value::fromObject(klass);
+    } else {
+        define(stmt->name, stmt->kind, Value::fromObject(klass));
+    }
+
+    heap->popRoots(1);
+}
+
+LoxUpvalue* Interpreter::declareCell(Expr::VariableKind kind)
+{
+    if (kind != Expr::VARIABLE_CELL) {
+        return nullptr;
+    }
+
+    // Closures made while declaring capture the cell, eg: recursive local functions
+    LoxUpvalue* cell = heap->track(new LoxUpvalue(Value()));
+    *stackTop++ = Value::fromObject(cell);
+
+    return cell;
+}
+
+LoxFunction* Interpreter::makeFunction(Stmt::Function* declaration, bool isInitializer, CompiledBlock* compiled)
+{
+    LoxFunction* function = heap->track(new LoxFunction(declaration, isInitializer));
+    function->compiled = compiled;
+
+    // Captured locals of the current frame are already boxed in cells
+    for (unsigned int i = 0; i < declaration->upvalues->size(); i++) {
+        Stmt::Capture& capture = declaration->upvalues->at(i);
+
+        if (capture.isLocal) {
+            function->upvalues[i] = static_cast<LoxUpvalue*>(frame[capture.index].asObject());
+        } else {
+            function->upvalues[i] = closure->upvalues[capture.index];
         }
-    } catch (RuntimeError* error) {
-        Lox::runtimeError(*error);
     }
 
-    this->environment = previous;
+    return function;
 }
 
-std::string* Interpreter::evaluate(Expr::Expr* expr)
+
+std::string Interpreter::stringify(Value object)
 {
-    return expr->accept(this);
+    return object.toString();
+}
+
+Stmt::Completion Interpreter::execute(Stmt::Stmt* stmt)
+{
+    return stmt->accept(this);
 }
 
-void Interpreter::resolve(Expr::Expr* expr, int depth)
+Stmt::Completion Interpreter::executeBlock(NodeList<Stmt::Stmt*>* statments)
 {
-    // Define variable's resolved location
-    (*locals)[expr] = depth;
+    Value* top = stackTop;
+    Stmt::Completion completion = executeStatements(statments);
+
+    // RuntimeError skips this, interpret() empties the stack instead
+    stackTop = top;
+
+    return completion;
 }
 
-std::string* Interpreter::isTruthy(std::string* object)
+Stmt::Completion Interpreter::executeBlock(CompiledBlock* block)
 {
-    if (
-        object == nullptr || 
-        *object == "nil"
-    ) {
-        return new std::string("false");
+    Value* top = stackTop;
+    Stmt::Completion completion = executeStatements(block);
+
+    stackTop = top;
+
+    return completion;
+}
+
+Stmt::Completion Interpreter::executeStatements(NodeList<Stmt::Stmt*>* statements)
+{
+    for (Stmt::Stmt* statement: *statements) {
+        Stmt::Completion completion = execute(statement);
+
+        // Statements after a return are skipped
+        if (completion != Stmt::COMPLETION_NORMAL) {
+            return completion;
+        }
     }
 
-    // return "true" or "false" as is
-    // Later handled by conversion methods
-    return object;
+    return Stmt::COMPLETION_NORMAL;
 }
 
-double Interpreter::string_to_double(std::string* literal)
-{    
-    return ::atof(literal->c_str());
+Stmt::Completion Interpreter::executeStatements(CompiledBlock* block)
+{
+    for (CompiledStmt& statement: block->statements) {
+        Stmt::Completion completion = statement();
+
+        if (completion != Stmt::COMPLETION_NORMAL) {
+            return completion;
+        }
+    }
+
+    return Stmt::COMPLETION_NORMAL;
 }
 
-bool Interpreter::isDouble(std::string* literal)
+Value Interpreter::callFunction(LoxFunction* function, Value* receiver, ArgumentSpan arguments)
 {
-    bool decimal = false;
+    // Each call also takes native stack for the visitors evaluating it,
+    // Lox::STACK_SIZE is sized for this many
+    if (callDepth() >= LoxCallable::MAX_CALL_DEPTH) {
+        throw new RuntimeError(function->declaration->name, "Stack overflow.");
+    }
+
+    Value* previousFrame = frame;
+    Value* previousTop = stackTop;
+    callers->push_back(closure);
+
+    // Read before 'this' can be boxed into a cell
+    Value self = receiver != nullptr ? *receiver : Value();
+
+    // Receiver and arguements pushed by Interpreter::call already are the
+    // first slots of the frame, others are copied to the top of the stack
+    bool inPlace = arguments.end() == stackTop
+        && (receiver == nullptr || receiver == arguments.begin() - 1);
+
+    if (inPlace) {
+        frame = receiver != nullptr ? receiver : arguments.begin();
+    } else {
+        frame = stackTop;
+    }
 
-    unsigned int i = literal->at(0) == '-' ? 1 : 0;
-    for (; i < literal->size(); i++) {
-        if (literal->at(i) == '.') {
-            if (decimal) {
-                return false;
-            } else {
-                decimal = true;
+    Stmt::Completion completion;
+
+    while (true) {
+        Stmt::Function* declaration = function->declaration;
+
+        if (frame + declaration->slotCount > stack + STACK_MAX) {
+            throw new RuntimeError(declaration->name, "Stack overflow.");
+        }
+
+        closure = function;
+
+        if (!inPlace) {
+            if (receiver != nullptr) {
+                *stackTop++ = *receiver;
+            }
+
+            for (Value argument: arguments) {
+                *stackTop++ = argument;
             }
-        } else if (
-            literal->at(i) < '0' || 
-            literal->at(i) > '9'
-        ) {
-            return false;
         }
+
+        // Parameters captured by closures move into cells before the body runs
+        for (int slot: *declaration->cellParameters) {
+            frame[slot] = Value::fromObject(heap->track(new LoxUpvalue(frame[slot])));
+        }
+
+        completion = function->compiled != nullptr
+            ? executeBlock(function->compiled)
+            : executeBlock(declaration->body);
+
+        if (completion != Stmt::COMPLETION_TAIL_CALL) {
+            break;
+        }
+
+        // Callee of a tail call reuses the frame, so tail recursion
+        // runs in constant space like a loop
+        function = tailFunction;
+        receiver = tailHasReceiver ? &tailReceiver : nullptr;
+        arguments = ArgumentSpan(tailArguments->data(), tailArguments->size());
+
+        tailFunction = nullptr;
+        stackTop = frame;
+        inPlace = false;
     }
 
-    return true;
+    frame = previousFrame;
+    stackTop = previousTop;
+    closure = callers->back();
+    callers->pop_back();
+
+    // Initializers return their receiver, even from a bare return
+    if (function->isInitializer) {
+        returnValue = Value();
+        return self;
+    }
+
+    if (completion == Stmt::COMPLETION_RETURN) {
+        Value value = returnValue;
+        returnValue = Value();
+
+        return value;
+    }
+
+    return Value();
+}
+
+int Interpreter::callDepth()
+{
+    return callers->size();
 }
 
-bool Interpreter::isEqual(std::string* a, std::string* b)
+void Interpreter::markRoots(Heap* heap)
 {
-    if (a == nullptr && b == nullptr) {
-        return true;
+    heap->markObject(globals);
+    heap->markValue(returnValue);
+
+    for (Value* slot = stack; slot < stackTop; slot++) {
+        heap->markValue(*slot);
+    }
+
+    heap->markObject(closure);
+    for (LoxFunction* caller: *callers) {
+        heap->markObject(caller);
     }
 
-    if (a == nullptr) {
+    if (tailFunction != nullptr) {
+        heap->markObject(tailFunction);
+        heap->markValue(tailReceiver);
+
+        for (Value argument: *tailArguments) {
+            heap->markValue(argument);
+        }
+    }
+}
+
+Value Interpreter::evaluate(Expr::Expr* expr)
+{
+    return expr->accept(this);
+}
+
+void Interpreter::define(Token* name, Expr::VariableKind kind, Value value)
+{
+    // Top level declarations are not tracked by the resolver
+    // Hence they are the only ones looked up by name
+    if (kind == Expr::VARIABLE_GLOBAL) {
+        globals->define(name->interned, value);
+        return;
+    }
+
+    if (kind == Expr::VARIABLE_CELL) {
+        heap->pushRoot(value);
+        value = Value::fromObject(heap->track(new LoxUpvalue(value)));
+        heap->popRoots(1);
+    }
+
+    *stackTop++ = value;
+}
+
+bool Interpreter::isTruthy(Value object)
+{
+    // nil and false are falsey, everything else is truthy
+    if (object.isNil()) {
         return false;
     }
 
-    // May need to handle string equivalent too
+    if (object.isBool()) {
+        return object.asBool();
+    }
 
-    return a->at(0) == b->at(0);
+    return true;
+}
+
+bool Interpreter::isEqual(Value a, Value b)
+{
+    return a.equals(b);
 }
 
-void Interpreter::checkNumberOperand(Token* operator_, std::string* operand)
+void Interpreter::checkNumberOperand(Token* operator_, Value operand)
 {
-    if (isDouble(operand)) {
+    if (operand.isNumber()) {
         return;
     }
 
@@ -484,9 +1158,9 @@ void Interpreter::checkNumberOperand(Token* operator_, std::string* operand)
 }
 
 
-void Interpreter::checkNumberOperands(Token* operator_, std::string* left, std::string* right)
+void Interpreter::checkNumberOperands(Token* operator_, Value left, Value right)
 {
-    if (isDouble(left) && isDouble(right)) {
+    if (left.isNumber() && right.isNumber()) {
         return;
     }
 
@@ -0,0 +1,36 @@
+#include "./../../include/Interpreter/LoxBoundMethod.h"
+#include "./../../include/Interpreter/LoxFunction.h"
+#include "./../../include/Interpreter/Heap.h"
+
+LoxBoundMethod::LoxBoundMethod(Value receiver, LoxObject* method)
+    : LoxCallable(ObjectType::OBJ_BOUND_METHOD)
+{
+    this->receiver = receiver;
+    this->method = method;
+}
+
+unsigned int LoxBoundMethod::arity()
+{
+    return static_cast<LoxFunction*>(method)->arity();
+}
+
+Value LoxBoundMethod::call(Interpreter* interpreter, ArgumentSpan arguments)
+{
+    return static_cast<LoxFunction*>(method)->callWithReceiver(interpreter, receiver, arguments);
+}
+
+std::string LoxBoundMethod::toString()
+{
+    return method->toString();
+}
+
+void LoxBoundMethod::trace(Heap* heap)
+{
+    heap->markValue(receiver);
+    heap->markObject(method);
+}
+
+std::size_t LoxBoundMethod::size()
+{
+    return sizeof(LoxBoundMethod);
+}
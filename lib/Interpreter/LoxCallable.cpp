@@ -1,6 +1,6 @@
 #include "./../../include/Interpreter/LoxCallable.h"
 
-LoxCallable::LoxCallable()
+LoxCallable::LoxCallable(ObjectType type) : LoxObject(type)
 {
     
 }
@@ -10,7 +10,7 @@ unsigned int LoxCallable::arity()
     return 0;
 }
 
-std::string* LoxCallable::call(Interpreter* interpreter, std::vector<std::string*>* arguments)
+Value LoxCallable::call(Interpreter* interpreter, ArgumentSpan arguments)
 {
-    return nullptr;
+    return Value();
 }
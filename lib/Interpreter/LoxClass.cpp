@@ -1,21 +1,99 @@
 #include "./../../include/Interpreter/LoxClass.h"
+#include "./../../include/Interpreter/Interpreter.h"
+#include "./../../include/Interpreter/StringTable.h"
 
-LoxClass::LoxClass(std::string* name)
+LoxClass::LoxClass(std::string name) : LoxCallable(ObjectType::OBJ_CLASS)
 {
     this->name = name;
+    this->methods = new std::unordered_map<LoxString*, LoxObject*>();
+    this->rootShape = new Shape();
+
+    this->shapes = new std::vector<Shape*>();
+    this->shapes->push_back(rootShape);
+}
+
+LoxClass::~LoxClass()
+{
+    for (Shape* shape: *shapes) {
+        delete shape;
+    }
+
+    delete shapes;
+    delete methods;
+}
+
+LoxObject* LoxClass::findMethod(LoxString* name)
+{
+    std::unordered_map<LoxString*, LoxObject*>::iterator method = methods->find(name);
+
+    if (method != methods->end()) {
+        return method->second;
+    }
+
+    return nullptr;
+}
+
+LoxString* LoxClass::initializerName()
+{
+    static LoxString* name = StringTable::global()->intern("init");
+    return name;
+}
+
+Shape* LoxClass::transition(Shape* from, LoxString* name)
+{
+    Shape* next = from->next(name);
+
+    if (next == nullptr) {
+        next = new Shape(from, name);
+
+        from->transitions.push_back(next);
+        shapes->push_back(next);
+    }
+
+    return next;
 }
 
 unsigned int LoxClass::arity()
 {
+    // Constructor takes the arguements of the initializer
+    LoxObject* initializer = findMethod(initializerName());
+
+    if (initializer != nullptr && initializer->type == ObjectType::OBJ_FUNCTION) {
+        return static_cast<LoxFunction*>(initializer)->arity();
+    }
+
     return 0;
 }
 
-std::string* LoxClass::call(Interpreter* interpreter, std::vector<std::string*>* arguments)
+Value LoxClass::call(Interpreter* interpreter, ArgumentSpan arguments)
 {
-    LoxInstance* instance = new LoxInstance(this);
+    LoxInstance* instance = interpreter->heap->track(new LoxInstance(this));
+    Value receiver = Value::fromObject(instance);
+
+    LoxObject* initializer = findMethod(initializerName());
+
+    if (initializer != nullptr) {
+        interpreter->heap->pushRoot(receiver);
+        static_cast<LoxFunction*>(initializer)->callWithReceiver(interpreter, receiver, arguments);
+        interpreter->heap->popRoots(1);
+    }
     
-    // Need to fix the call method because of this
-    return static_cast<std::string*>(
-        static_cast<void*>(instance)
-    );
+    return receiver;
+}
+
+std::string LoxClass::toString()
+{
+    return name;
+}
+
+void LoxClass::trace(Heap* heap)
+{
+    for (std::pair<LoxString* const, LoxObject*>& method: *methods) {
+        heap->markObject(method.second);
+    }
+}
+
+std::size_t LoxClass::size()
+{
+    return sizeof(LoxClass) + sizeof(Shape);
 }
@@ -1,9 +1,17 @@
 #include "./../../include/Interpreter/LoxFunction.h"
+#include "./../../include/Jit/Jit.h"
 
-LoxFunction::LoxFunction(Stmt::Function* declaration, Environment* closure)
+LoxFunction::LoxFunction(Stmt::Function* declaration, bool isInitializer)
+    : LoxCallable(ObjectType::OBJ_FUNCTION)
 {
     this->declaration = declaration;
-    this->closure = closure;
+    this->isInitializer = isInitializer;
+    this->compiled = nullptr;
+    this->calls = 0;
+    this->jitted = nullptr;
+
+    // Filled by the interpreter right after creation
+    this->upvalues.resize(declaration->upvalues->size(), nullptr);
 }
 
 unsigned int LoxFunction::arity()
@@ -11,31 +19,48 @@ unsigned int LoxFunction::arity()
     return declaration->params->size();
 }
 
-std::string* LoxFunction::call(Interpreter* interpreter, std::vector<std::string*>* arguments)
+Value LoxFunction::call(Interpreter* interpreter, ArgumentSpan arguments)
 {
-    // Creating local scope for Function call 
-    // with closure environment as it parent
-    Environment* environment = new Environment(closure);
-
-    // Binding each arguement pair in Environment
-    for (unsigned int i = 0; i < declaration->params->size(); i++) {
-        environment->define(
-            declaration->params->at(i)->lexeme,
-            static_cast<void*>(arguments->at(i))
-        );
+    // Hot functions run as machine code while they are called with numbers
+    Jit* jit = interpreter->jit;
+
+    if (jit->enabled) {
+        if (jitted == nullptr && ++calls >= Jit::HOT_CALLS) {
+            jitted = jit->compile(declaration);
+        }
+
+        Value result;
+        if (jitted != nullptr && jit->run(jitted, arguments, interpreter->callDepth(), &result)) {
+            return result;
+        }
     }
 
-    try {
-        interpreter->executeBlock(declaration->body, environment);
-    } catch (Runtime::Return* returnValue) {
-        // Used to return from callstack 
-        return static_cast<std::string*>(returnValue->value);
+    return interpreter->callFunction(this, nullptr, arguments);
+}
+
+Value LoxFunction::callWithReceiver(Interpreter* interpreter, Value receiver, ArgumentSpan arguments)
+{
+    return interpreter->callFunction(this, &receiver, arguments);
+}
+
+std::string LoxFunction::toString()
+{
+    return "<fn " + declaration->name->lexeme() + ">";
+}
+
+void LoxFunction::trace(Heap* heap)
+{
+    for (LoxUpvalue* upvalue: upvalues) {
+        heap->markObject(upvalue);
     }
+}
 
-    return nullptr;
+std::size_t LoxFunction::size()
+{
+    return sizeof(LoxFunction) + upvalues.capacity() * sizeof(LoxUpvalue*);
 }
 
 std::ostream& operator<<(std::ostream& os, const LoxFunction& t) {
-    os << "<fn " + *t.declaration->name->lexeme + ">";
+    os << "<fn " + t.declaration->name->lexeme() + ">";
     return os;
 }
\ No newline at end of file
@@ -1,27 +1,92 @@
 #include "./../../include/Interpreter/LoxInstance.h"
+#include "./../../include/Interpreter/LoxClass.h"
+#include "./../../include/Interpreter/Heap.h"
 
-LoxInstance::LoxInstance(LoxClass* klass)
+LoxInstance::LoxInstance(LoxClass* klass) : LoxObject(ObjectType::OBJ_INSTANCE)
 {
     this->klass = klass;
-    this->fields = new std::unordered_map<std::string, void*>();
+    this->shape = klass->rootShape;
 
+    this->extraFields = nullptr;
+    this->extraCapacity = 0;
 }
 
-void* LoxInstance::get(Token* name)
+LoxInstance::~LoxInstance()
 {
-    if (fields->find(*name->lexeme) != fields->end()) {
-        return fields->at(*name->lexeme);
+    delete[] extraFields;
+}
+
+bool LoxInstance::getField(LoxString* name, Value* value)
+{
+    int offset = shape->find(name);
+
+    if (offset == -1) {
+        return false;
     }
 
-    // If the property does not exist then a runtime error is throw
-    throw new RuntimeError(name,
-        "Undefined property '" + *name->lexeme + "'."
-    );
+    *value = field(offset);
+    return true;
 }
 
-void LoxInstance::set(Token* name, void* value)
+void LoxInstance::setField(LoxString* name, Value value)
 {
     // Since freely creation of new fields on instances are allowed
     // No need for checking of field
-    (*fields)[*name->lexeme] = nullptr;
-}
\ No newline at end of file
+    int offset = shape->find(name);
+
+    if (offset != -1) {
+        field(offset) = value;
+        return;
+    }
+
+    addField(klass->transition(shape, name), value);
+}
+
+Value& LoxInstance::field(int offset)
+{
+    if (offset < INLINE_FIELDS) {
+        return inlineFields[offset];
+    }
+
+    return extraFields[offset - INLINE_FIELDS];
+}
+
+void LoxInstance::addField(Shape* next, Value value)
+{
+    int extra = next->fieldCount - INLINE_FIELDS;
+
+    if (extra > extraCapacity) {
+        int capacity = extraCapacity == 0 ? INLINE_FIELDS : extraCapacity * 2;
+        Value* fields = new Value[capacity];
+
+        for (int i = 0; i < extraCapacity; i++) {
+            fields[i] = extraFields[i];
+        }
+
+        delete[] extraFields;
+        extraFields = fields;
+        extraCapacity = capacity;
+    }
+
+    shape = next;
+    field(next->fieldCount - 1) = value;
+}
+
+std::string LoxInstance::toString()
+{
+    return klass->name + " instance";
+}
+
+void LoxInstance::trace(Heap* heap)
+{
+    heap->markObject(klass);
+
+    for (int i = 0; i < shape->fieldCount; i++) {
+        heap->markValue(field(i));
+    }
+}
+
+std::size_t LoxInstance::size()
+{
+    return sizeof(LoxInstance) + extraCapacity * sizeof(Value);
+}
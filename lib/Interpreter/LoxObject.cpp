@@ -0,0 +1,11 @@
+#include "./../../include/Interpreter/LoxObject.h"
+
+LoxObject::LoxObject(ObjectType type)
+{
+    this->type = type;
+}
+
+LoxObject::~LoxObject()
+{
+
+}
@@ -0,0 +1,141 @@
+#include <vector>
+
+#include "./../../include/Interpreter/LoxString.h"
+#include "./../../include/Interpreter/Heap.h"
+#include "./../../include/Interpreter/StringTable.h"
+
+LoxString::LoxString(std::string value) : LoxObject(ObjectType::OBJ_STRING)
+{
+    this->value = value;
+    this->length_ = this->value.length();
+    this->left = nullptr;
+    this->right = nullptr;
+    this->interned = false;
+    this->hash = 0;
+    this->canonical_ = nullptr;
+    this->lookedUp = false;
+}
+
+LoxString::LoxString(LoxString* left, LoxString* right) : LoxObject(ObjectType::OBJ_STRING)
+{
+    this->length_ = left->length() + right->length();
+    this->left = left;
+    this->right = right;
+    this->interned = false;
+    this->hash = 0;
+    this->canonical_ = nullptr;
+    this->lookedUp = false;
+}
+
+const std::string& LoxString::text()
+{
+    if (left != nullptr) {
+        flatten();
+    }
+
+    return value;
+}
+
+std::size_t LoxString::length() const
+{
+    return length_;
+}
+
+LoxString* LoxString::canonical()
+{
+    if (interned) {
+        return this;
+    }
+
+    if (!lookedUp) {
+        const std::string& chars = text();
+
+        hash = StringTable::hash(chars.data(), chars.length());
+        canonical_ = StringTable::global()->find(chars.data(), chars.length(), hash);
+        lookedUp = true;
+    }
+
+    return canonical_;
+}
+
+LoxString* LoxString::concatenate(Heap* heap, LoxString* left, LoxString* right)
+{
+    // Strings never change, so either half can stand for the result
+    if (right->length() == 0) {
+        return left;
+    }
+
+    if (left->length() == 0) {
+        return right;
+    }
+
+    if (left->length() + right->length() < ROPE_MIN_LENGTH) {
+        return heap->track(new LoxString(left->text() + right->text()));
+    }
+
+    return heap->track(new LoxString(left, right));
+}
+
+LoxString* LoxString::concatenate(Heap* heap, LoxString* left, const std::string& right)
+{
+    if (left->length() + right.length() < ROPE_MIN_LENGTH) {
+        return heap->track(new LoxString(left->text() + right));
+    }
+
+    // Tracking the rope can collect, the new half is only rooted here
+    LoxString* tail = heap->track(new LoxString(right));
+
+    heap->pushRoot(Value::fromObject(tail));
+    LoxString* rope = concatenate(heap, left, tail);
+    heap->popRoots(1);
+
+    return rope;
+}
+
+std::string LoxString::toString()
+{
+    return text();
+}
+
+void LoxString::trace(Heap* heap)
+{
+    heap->markObject(left);
+    heap->markObject(right);
+}
+
+std::size_t LoxString::size()
+{
+    return sizeof(LoxString) + value.capacity();
+}
+
+void LoxString::flatten()
+{
+    // Appending to a string in a loop builds ropes as deep as the loop is long,
+    // so they are walked with an explicit stack instead of recursing
+    std::string flat;
+    flat.reserve(length_);
+
+    std::vector<LoxString*> pending;
+    pending.push_back(right);
+    LoxString* node = left;
+
+    while (true) {
+        while (node->left != nullptr) {
+            pending.push_back(node->right);
+            node = node->left;
+        }
+
+        flat += node->value;
+
+        if (pending.empty()) {
+            break;
+        }
+
+        node = pending.back();
+        pending.pop_back();
+    }
+
+    value.swap(flat);
+    left = nullptr;
+    right = nullptr;
+}
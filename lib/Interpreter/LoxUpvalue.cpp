@@ -0,0 +1,22 @@
+#include "./../../include/Interpreter/LoxUpvalue.h"
+#include "./../../include/Interpreter/Heap.h"
+
+LoxUpvalue::LoxUpvalue(Value value) : LoxObject(ObjectType::OBJ_UPVALUE)
+{
+    this->value = value;
+}
+
+std::string LoxUpvalue::toString()
+{
+    return "upvalue";
+}
+
+void LoxUpvalue::trace(Heap* heap)
+{
+    heap->markValue(value);
+}
+
+std::size_t LoxUpvalue::size()
+{
+    return sizeof(LoxUpvalue);
+}
@@ -0,0 +1,368 @@
+#include "./../../include/Interpreter/NumberFormatter.h"
+
+#include <cmath>
+#include <cstring>
+
+// Grisu2 as described by Florian Loitsch in
+// "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+
+/**
+ * Floating point number with a 64 bit significand, f * 2^e
+ * Products are rounded, which is what the boundaries below account for
+ */
+struct DiyFp
+{
+    std::uint64_t f;
+    int e;
+
+    DiyFp(std::uint64_t f, int e) : f(f), e(e) {}
+
+    DiyFp operator-(const DiyFp& other) const
+    {
+        return DiyFp(f - other.f, e);
+    }
+
+    DiyFp operator*(const DiyFp& other) const
+    {
+        // High 64 bits of the 128 bit product, rounded
+        const std::uint64_t mask = 0xFFFFFFFFULL;
+        std::uint64_t a = f >> 32, b = f & mask;
+        std::uint64_t c = other.f >> 32, d = other.f & mask;
+        std::uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+
+        std::uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask) + (1ULL << 31);
+
+        return DiyFp(ac + (ad >> 32) + (bc >> 32) + (middle >> 32), e + other.e + 64);
+    }
+};
+
+static const std::uint64_t HIDDEN_BIT = 0x0010000000000000ULL;
+static const std::uint64_t SIGNIFICAND_MASK = 0x000FFFFFFFFFFFFFULL;
+
+// 10^k for k = -348, -340, ..., 340, normalized to f * 2^e
+static const std::uint64_t CACHED_POWERS_F[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const std::int16_t CACHED_POWERS_E[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const std::uint64_t POWERS_OF_10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+    10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static DiyFp fromDouble(double number)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+
+    int biasedExponent = (int)((bits >> 52) & 0x7FF);
+    std::uint64_t significand = bits & SIGNIFICAND_MASK;
+
+    // Subnormals have no hidden bit
+    if (biasedExponent == 0) {
+        return DiyFp(significand, -1074);
+    }
+
+    return DiyFp(significand + HIDDEN_BIT, biasedExponent - 1075);
+}
+
+static DiyFp normalize(DiyFp value)
+{
+    while ((value.f & (1ULL << 63)) == 0) {
+        value.f <<= 1;
+        value.e--;
+    }
+
+    return value;
+}
+
+// Halfway points to the neighbouring doubles, every number between them reads back as v
+static void boundaries(DiyFp v, DiyFp* minus, DiyFp* plus)
+{
+    DiyFp upper((v.f << 1) + 1, v.e - 1);
+    while ((upper.f & (HIDDEN_BIT << 1)) == 0) {
+        upper.f <<= 1;
+        upper.e--;
+    }
+    upper.f <<= 10;
+    upper.e -= 10;
+
+    // The gap below a power of 2 is half the gap above it
+    DiyFp lower = v.f == HIDDEN_BIT
+        ? DiyFp((v.f << 2) - 1, v.e - 2)
+        : DiyFp((v.f << 1) - 1, v.e - 1);
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    *minus = lower;
+    *plus = upper;
+}
+
+// Cached power bringing a number of binary exponent e in range of 64 bit digit generation
+static DiyFp cachedPower(int e, int* decimalExponent)
+{
+    // 0.30102999566398114 is log10(2)
+    double estimate = (-61 - e) * 0.30102999566398114 + 347;
+    int k = (int)estimate;
+    if (estimate - k > 0.0) {
+        k++;
+    }
+
+    int index = (k >> 3) + 1;
+    *decimalExponent = -(-348 + index * 8);
+
+    return DiyFp(CACHED_POWERS_F[index], CACHED_POWERS_E[index]);
+}
+
+static int countDigits(std::uint32_t n)
+{
+    int count = 1;
+    while (count < 10 && n >= POWERS_OF_10[count]) {
+        count++;
+    }
+
+    return count;
+}
+
+// Moves the last digit towards w while the result stays within the boundaries
+static void round(char* digits, int length, std::uint64_t delta, std::uint64_t rest,
+    std::uint64_t tenKappa, std::uint64_t distance)
+{
+    while (rest < distance && delta - rest >= tenKappa
+        && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)
+    ) {
+        digits[length - 1]--;
+        rest += tenKappa;
+    }
+}
+
+static int generateDigits(DiyFp w, DiyFp upper, std::uint64_t delta, char* digits, int* exponent)
+{
+    DiyFp one(1ULL << -upper.e, upper.e);
+    std::uint64_t distance = (upper - w).f;
+
+    // Integral and fractional parts of the upper boundary
+    std::uint32_t integral = (std::uint32_t)(upper.f >> -one.e);
+    std::uint64_t fraction = upper.f & (one.f - 1);
+
+    int kappa = countDigits(integral);
+    int length = 0;
+
+    while (kappa > 0) {
+        std::uint32_t divisor = (std::uint32_t)POWERS_OF_10[kappa - 1];
+        std::uint32_t digit = integral / divisor;
+        integral %= divisor;
+
+        if (digit != 0 || length != 0) {
+            digits[length++] = (char)('0' + digit);
+        }
+
+        kappa--;
+
+        std::uint64_t rest = ((std::uint64_t)integral << -one.e) + fraction;
+        if (rest <= delta) {
+            *exponent += kappa;
+            round(digits, length, delta, rest, POWERS_OF_10[kappa] << -one.e, distance);
+            return length;
+        }
+    }
+
+    while (true) {
+        fraction *= 10;
+        delta *= 10;
+
+        char digit = (char)(fraction >> -one.e);
+        if (digit != 0 || length != 0) {
+            digits[length++] = (char)('0' + digit);
+        }
+
+        fraction &= one.f - 1;
+        kappa--;
+
+        if (fraction < delta) {
+            *exponent += kappa;
+            int index = -kappa;
+            round(digits, length, delta, fraction, one.f, index < 20 ? distance * POWERS_OF_10[index] : 0);
+            return length;
+        }
+    }
+}
+
+std::string NumberFormatter::format(double number)
+{
+    char buffer[MAX_LENGTH];
+    std::size_t length = format(number, buffer);
+
+    return std::string(buffer, length);
+}
+
+std::size_t NumberFormatter::format(double number, char* buffer)
+{
+    std::size_t length = 0;
+
+    if (std::signbit(number)) {
+        buffer[length++] = '-';
+        number = -number;
+    }
+
+    // Same spellings as the C library
+    if (std::isnan(number)) {
+        std::memcpy(buffer + length, "nan", 3);
+        return length + 3;
+    }
+
+    if (std::isinf(number)) {
+        std::memcpy(buffer + length, "inf", 3);
+        return length + 3;
+    }
+
+    if (number == 0) {
+        buffer[length++] = '0';
+        return length;
+    }
+
+    // Loop counters and most arithmetic results
+    if (number < 9007199254740992.0 && number == std::floor(number)) {
+        return length + formatInteger((std::uint64_t)number, buffer + length);
+    }
+
+    int exponent;
+    int digits = grisu2(number, buffer + length, &exponent);
+
+    return length + prettify(buffer + length, digits, exponent);
+}
+
+std::size_t NumberFormatter::formatInteger(std::uint64_t integer, char* buffer)
+{
+    char digits[20];
+    std::size_t count = 0;
+
+    while (integer != 0) {
+        digits[count++] = (char)('0' + integer % 10);
+        integer /= 10;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        buffer[i] = digits[count - 1 - i];
+    }
+
+    return count;
+}
+
+int NumberFormatter::grisu2(double number, char* digits, int* exponent)
+{
+    DiyFp v = fromDouble(number);
+    DiyFp minus(0, 0), plus(0, 0);
+    boundaries(v, &minus, &plus);
+
+    int decimalExponent;
+    DiyFp power = cachedPower(plus.e, &decimalExponent);
+
+    DiyFp w = normalize(v) * power;
+    DiyFp upper = plus * power;
+    DiyFp lower = minus * power;
+
+    // Products are off by at most one unit, the boundaries shrink to stay safe
+    upper.f--;
+    lower.f++;
+
+    *exponent = decimalExponent;
+
+    return generateDigits(w, upper, upper.f - lower.f, digits, exponent);
+}
+
+std::size_t NumberFormatter::prettify(char* buffer, int length, int exponent)
+{
+    // Position of the decimal point relative to the first digit
+    int point = length + exponent;
+
+    if (length <= point && point <= 21) {
+        // Integer, eg: 1234e7 -> 12340000000
+        std::memset(buffer + length, '0', point - length);
+        return point;
+    }
+
+    if (0 < point && point <= 21) {
+        // Fraction, eg: 1234e-2 -> 12.34
+        std::memmove(buffer + point + 1, buffer + point, length - point);
+        buffer[point] = '.';
+        return length + 1;
+    }
+
+    if (-6 < point && point <= 0) {
+        // Small fraction, eg: 1234e-6 -> 0.001234
+        int zeros = 2 - point;
+        std::memmove(buffer + zeros, buffer, length);
+        buffer[0] = '0';
+        buffer[1] = '.';
+        std::memset(buffer + 2, '0', -point);
+        return length + zeros;
+    }
+
+    // Scientific, eg: 1234e30 -> 1.234e+33
+    std::size_t size = 1;
+    if (length > 1) {
+        std::memmove(buffer + 2, buffer + 1, length - 1);
+        buffer[1] = '.';
+        size = length + 1;
+    }
+
+    int shown = point - 1;
+    buffer[size++] = 'e';
+    buffer[size++] = shown < 0 ? '-' : '+';
+    if (shown < 0) {
+        shown = -shown;
+    }
+
+    if (shown >= 100) {
+        buffer[size++] = (char)('0' + shown / 100);
+        shown %= 100;
+        buffer[size++] = (char)('0' + shown / 10);
+    } else if (shown >= 10) {
+        buffer[size++] = (char)('0' + shown / 10);
+    }
+    buffer[size++] = (char)('0' + shown % 10);
+
+    return size;
+}
@@ -1,6 +0,0 @@
-#include "./../../include/Interpreter/Return.h"
-
-Runtime::Return::Return(void* value) : std::runtime_error("")
-{
-    this->value = value;
-}
\ No newline at end of file
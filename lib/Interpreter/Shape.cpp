@@ -0,0 +1,69 @@
+#include "./../../include/Interpreter/Shape.h"
+
+unsigned long Shape::nextId = 0;
+
+Shape::Shape()
+{
+    this->id = nextId++;
+    this->parent = nullptr;
+    this->name = nullptr;
+    this->fieldCount = 0;
+    this->offsets = std::make_shared<std::unordered_map<LoxString*, int>>();
+}
+
+Shape::Shape(Shape* parent, LoxString* name)
+{
+    this->id = nextId++;
+    this->parent = parent;
+    this->name = name;
+    this->fieldCount = parent->fieldCount + 1;
+
+    // Extending the last shape of a chain shares its table, a shape that
+    // branches off earlier copies the fields it inherits into a new one
+    if (parent->offsets->size() == (std::size_t)parent->fieldCount) {
+        this->offsets = parent->offsets;
+    } else {
+        this->offsets = std::make_shared<std::unordered_map<LoxString*, int>>();
+
+        for (Shape* shape = parent; shape->parent != nullptr; shape = shape->parent) {
+            (*offsets)[shape->name] = shape->fieldCount - 1;
+        }
+    }
+
+    (*offsets)[name] = fieldCount - 1;
+}
+
+int Shape::find(LoxString* name)
+{
+    if (fieldCount > LINEAR_SEARCH_MAX) {
+        std::unordered_map<LoxString*, int>::iterator offset = offsets->find(name);
+
+        // Fields added after this shape on the same chain are not its own
+        if (offset != offsets->end() && offset->second < fieldCount) {
+            return offset->second;
+        }
+
+        return -1;
+    }
+
+    // Walking towards the root, each shape knows the offset of its own field
+    // Names are interned, so comparing them is comparing pointers
+    for (Shape* shape = this; shape->parent != nullptr; shape = shape->parent) {
+        if (shape->name == name) {
+            return shape->fieldCount - 1;
+        }
+    }
+
+    return -1;
+}
+
+Shape* Shape::next(LoxString* name)
+{
+    for (Shape* transition: transitions) {
+        if (transition->name == name) {
+            return transition;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,107 @@
+#include "./../../include/Interpreter/StringTable.h"
+
+#include <cstring>
+
+StringTable::StringTable()
+{
+    this->entries.resize(256, nullptr);
+    this->count = 0;
+}
+
+StringTable* StringTable::global()
+{
+    static StringTable* table = new StringTable();
+    return table;
+}
+
+LoxString* StringTable::intern(const char* chars, std::size_t length)
+{
+    std::size_t hash = StringTable::hash(chars, length);
+
+    LoxString* found = find(chars, length, hash);
+    if (found != nullptr) {
+        return found;
+    }
+
+    std::size_t mask = entries.size() - 1;
+
+    LoxString* string = new LoxString(std::string(chars, length));
+    string->hash = hash;
+    string->interned = true;
+
+    // Kept at most 3/4 full so probe sequences stay short
+    if ((count + 1) * 4 > entries.size() * 3) {
+        grow();
+        mask = entries.size() - 1;
+    }
+
+    std::size_t index = hash & mask;
+    while (entries[index] != nullptr) {
+        index = (index + 1) & mask;
+    }
+
+    entries[index] = string;
+    count++;
+
+    return string;
+}
+
+LoxString* StringTable::intern(const std::string& text)
+{
+    return intern(text.data(), text.length());
+}
+
+LoxString* StringTable::find(const char* chars, std::size_t length, std::size_t hash)
+{
+    std::size_t mask = entries.size() - 1;
+
+    for (std::size_t index = hash & mask; ; index = (index + 1) & mask) {
+        LoxString* entry = entries[index];
+
+        if (entry == nullptr) {
+            return nullptr;
+        }
+
+        if (entry->hash == hash
+            && entry->length() == length
+            && std::memcmp(entry->text().data(), chars, length) == 0
+        ) {
+            return entry;
+        }
+    }
+}
+
+std::size_t StringTable::hash(const char* chars, std::size_t length)
+{
+    std::size_t hash = 2166136261u;
+
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)chars[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+void StringTable::grow()
+{
+    std::vector<LoxString*> old;
+    old.swap(entries);
+    entries.resize(old.size() * 2, nullptr);
+
+    std::size_t mask = entries.size() - 1;
+
+    // Hashes are stored, so moving entries never rehashes their text
+    for (LoxString* entry: old) {
+        if (entry == nullptr) {
+            continue;
+        }
+
+        std::size_t index = entry->hash & mask;
+        while (entries[index] != nullptr) {
+            index = (index + 1) & mask;
+        }
+
+        entries[index] = entry;
+    }
+}
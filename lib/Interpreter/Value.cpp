@@ -0,0 +1,93 @@
+#include "./../../include/Interpreter/Value.h"
+#include "./../../include/Interpreter/LoxString.h"
+#include "./../../include/Interpreter/LoxCallable.h"
+#include "./../../include/Interpreter/LoxInstance.h"
+#include "./../../include/Interpreter/NumberFormatter.h"
+
+LoxString* Value::asString() const
+{
+    return static_cast<LoxString*>(as.object);
+}
+
+LoxCallable* Value::asCallable() const
+{
+    return static_cast<LoxCallable*>(as.object);
+}
+
+LoxInstance* Value::asInstance() const
+{
+    return static_cast<LoxInstance*>(as.object);
+}
+
+bool Value::equals(Value other) const
+{
+    if (type != other.type) {
+        return false;
+    }
+
+    switch (type) {
+        case VAL_NIL:
+            return true;
+
+        case VAL_BOOL:
+            return as.boolean == other.as.boolean;
+
+        case VAL_NUMBER:
+            return as.number == other.as.number;
+
+        case VAL_OBJECT:
+            if (isString() && other.isString()) {
+                LoxString* a = asString();
+                LoxString* b = other.asString();
+
+                // Distinct interned strings never have the same text
+                if (a == b || (a->interned && b->interned)) {
+                    return a == b;
+                }
+
+                if (a->length() != b->length()) {
+                    return false;
+                }
+
+                // Runtime strings are interned on demand by their first
+                // comparison, then comparing them to literals, names or each
+                // other is comparing addresses
+                LoxString* canonicalA = a->canonical();
+                LoxString* canonicalB = b->canonical();
+
+                if (canonicalA != nullptr && canonicalB != nullptr) {
+                    return canonicalA == canonicalB;
+                }
+
+                // Both hashes are known after the lookups
+                if (a->hash != b->hash) {
+                    return false;
+                }
+
+                return a->text() == b->text();
+            }
+
+            return as.object == other.as.object;
+    }
+
+    return false;
+}
+
+std::string Value::toString() const
+{
+    switch (type) {
+        case VAL_NIL:
+            return "nil";
+
+        case VAL_BOOL:
+            return as.boolean ? "true" : "false";
+
+        case VAL_NUMBER:
+            return NumberFormatter::format(as.number);
+
+        case VAL_OBJECT:
+            return as.object->toString();
+    }
+
+    return "";
+}
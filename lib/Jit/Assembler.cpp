@@ -0,0 +1,285 @@
+#include "./../../include/Jit/Assembler.h"
+
+#include <cstring>
+
+// Register numbers used in ModRM bytes
+static const uint8_t RAX = 0;
+static const uint8_t RBX = 3;
+static const uint8_t RBP = 5;
+static const uint8_t RDI = 7;
+
+static uint8_t modRm(uint8_t mod, uint8_t reg, uint8_t rm)
+{
+    return (uint8_t)((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+}
+
+int Assembler::prologue()
+{
+    // push rbp; mov rbp, rsp; push rbx
+    emit(0x55);
+    emit(0x48); emit(0x89); emit(0xE5);
+    emit(0x53);
+
+    // sub rsp, frame size
+    emit(0x48); emit(0x81); emit(0xEC);
+    int offset = size();
+    emit32(0);
+
+    // mov rbx, rsi, the JitContext
+    emit(0x48); emit(0x89); emit(0xF3);
+
+    return offset;
+}
+
+void Assembler::patchFrameSize(int offset, int slotCount)
+{
+    // rsp is 16 byte aligned at call sites once rbp, rbx and the slots are pushed
+    int32_t frameSize = slotCount * 8;
+    if (frameSize % 16 != 8) {
+        frameSize += 8;
+    }
+
+    std::memcpy(&code[offset], &frameSize, sizeof(frameSize));
+}
+
+void Assembler::epilogue()
+{
+    // mov rbx, [rbp - 8]; leave; ret
+    emit(0x48); emit(0x8B); emit(modRm(1, RBX, RBP)); emit(0xF8);
+    emit(0xC9);
+    emit(0xC3);
+}
+
+void Assembler::loadArgument(int index, int slot)
+{
+    // movsd xmm0, [rdi + index * 8]
+    emit(0xF2); emit(0x0F); emit(0x10);
+    emit(modRm(2, 0, RDI));
+    emit32(index * 8);
+
+    storeSlot(slot);
+}
+
+void Assembler::loadSlot(int slot)
+{
+    slotInstruction(0x10, 0, slot);
+}
+
+void Assembler::storeSlot(int slot)
+{
+    slotInstruction(0x11, 0, slot);
+}
+
+void Assembler::loadLeftOperand(int slot)
+{
+    // movsd xmm1, xmm0
+    emit(0xF2); emit(0x0F); emit(0x10); emit(modRm(3, 1, 0));
+
+    slotInstruction(0x10, 0, slot);
+}
+
+void Assembler::loadNumber(double number)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+
+    // mov rax, bits; movq xmm0, rax
+    emit(0x48); emit(0xB8); emit64(bits);
+    emit(0x66); emit(0x48); emit(0x0F); emit(0x6E); emit(modRm(3, 0, RAX));
+}
+
+void Assembler::loadBool(bool boolean)
+{
+    // mov eax, boolean
+    emit(0xB8);
+    emit32(boolean ? 1 : 0);
+}
+
+void Assembler::arithmetic(TokenType operator_)
+{
+    uint8_t opcode;
+
+    switch (operator_) {
+        case PLUS: opcode = 0x58; break;
+        case MINUS: opcode = 0x5C; break;
+        case STAR: opcode = 0x59; break;
+        default: opcode = 0x5E; break;
+    }
+
+    // addsd, subsd, mulsd or divsd xmm0, xmm1
+    emit(0xF2); emit(0x0F); emit(opcode); emit(modRm(3, 0, 1));
+}
+
+void Assembler::compare(TokenType operator_)
+{
+    // ucomisd sets CF for below and unordered, so a < b is tested
+    // as b > a to make comparisons with NaN false
+    bool swapped = operator_ == LESS || operator_ == LESS_EQUAL;
+
+    // ucomisd xmm0, xmm1 or ucomisd xmm1, xmm0
+    emit(0x66); emit(0x0F); emit(0x2E);
+    emit(swapped ? modRm(3, 1, 0) : modRm(3, 0, 1));
+
+    switch (operator_) {
+        case GREATER:
+        case LESS:
+            // seta al
+            emit(0x0F); emit(0x97); emit(0xC0);
+            break;
+
+        case GREATER_EQUAL:
+        case LESS_EQUAL:
+            // setae al
+            emit(0x0F); emit(0x93); emit(0xC0);
+            break;
+
+        case EQUAL_EQUAL:
+            // sete al; setnp cl; and al, cl
+            emit(0x0F); emit(0x94); emit(0xC0);
+            emit(0x0F); emit(0x9B); emit(0xC1);
+            emit(0x20); emit(0xC8);
+            break;
+
+        default:
+            // setne al; setp cl; or al, cl
+            emit(0x0F); emit(0x95); emit(0xC0);
+            emit(0x0F); emit(0x9A); emit(0xC1);
+            emit(0x08); emit(0xC8);
+            break;
+    }
+
+    // movzx eax, al
+    emit(0x0F); emit(0xB6); emit(0xC0);
+}
+
+void Assembler::negate()
+{
+    // Flipping the sign bit keeps -0 distinct from 0
+    // mov rax, sign bit; movq xmm1, rax; xorpd xmm0, xmm1
+    emit(0x48); emit(0xB8); emit64(0x8000000000000000ULL);
+    emit(0x66); emit(0x48); emit(0x0F); emit(0x6E); emit(modRm(3, 1, RAX));
+    emit(0x66); emit(0x0F); emit(0x57); emit(modRm(3, 0, 1));
+}
+
+void Assembler::not_()
+{
+    // xor eax, 1
+    emit(0x83); emit(0xF0); emit(0x01);
+}
+
+int Assembler::jump()
+{
+    // jmp rel32
+    emit(0xE9);
+    int offset = size();
+    emit32(0);
+
+    return offset;
+}
+
+int Assembler::jumpIfFalse()
+{
+    // test eax, eax; jz rel32
+    emit(0x85); emit(0xC0);
+    emit(0x0F); emit(0x84);
+    int offset = size();
+    emit32(0);
+
+    return offset;
+}
+
+int Assembler::jumpIfTrue()
+{
+    // test eax, eax; jnz rel32
+    emit(0x85); emit(0xC0);
+    emit(0x0F); emit(0x85);
+    int offset = size();
+    emit32(0);
+
+    return offset;
+}
+
+int Assembler::jumpIfBailout()
+{
+    // cmp dword [rbx], 0; jne rel32
+    emit(0x83); emit(modRm(0, 7, RBX)); emit(0x00);
+    emit(0x0F); emit(0x85);
+    int offset = size();
+    emit32(0);
+
+    return offset;
+}
+
+void Assembler::patchJump(int offset)
+{
+    // Relative to the end of the 4 byte displacement
+    int32_t distance = size() - (offset + 4);
+    std::memcpy(&code[offset], &distance, sizeof(distance));
+}
+
+void Assembler::jumpBack(int target)
+{
+    emit(0xE9);
+    emit32(target - (size() + 4));
+}
+
+void Assembler::setBailout()
+{
+    // mov dword [rbx], 1
+    emit(0xC7); emit(modRm(0, 0, RBX)); emit32(1);
+}
+
+void Assembler::callHelper(void* helper, void* site, int firstArgumentSlot)
+{
+    // mov rdi, rbx
+    emit(0x48); emit(0x89); emit(modRm(3, RBX, RDI));
+
+    // mov rsi, site
+    emit(0x48); emit(0xBE); emit64((uint64_t)site);
+
+    // lea rdx, [rbp + offset of the first arguement]
+    emit(0x48); emit(0x8D); emit(modRm(2, 2, RBP));
+    emit32(slotOffset(firstArgumentSlot));
+
+    // mov rax, helper; call rax
+    emit(0x48); emit(0xB8); emit64((uint64_t)helper);
+    emit(0xFF); emit(0xD0);
+}
+
+int Assembler::size()
+{
+    return code.size();
+}
+
+void Assembler::emit(uint8_t byte)
+{
+    code.push_back(byte);
+}
+
+void Assembler::emit32(int32_t value)
+{
+    uint8_t bytes[4];
+    std::memcpy(bytes, &value, sizeof(bytes));
+    code.insert(code.end(), bytes, bytes + 4);
+}
+
+void Assembler::emit64(uint64_t value)
+{
+    uint8_t bytes[8];
+    std::memcpy(bytes, &value, sizeof(bytes));
+    code.insert(code.end(), bytes, bytes + 8);
+}
+
+void Assembler::slotInstruction(uint8_t opcode, int xmm, int slot)
+{
+    // movsd xmm, [rbp + offset] or movsd [rbp + offset], xmm
+    emit(0xF2); emit(0x0F); emit(opcode);
+    emit(modRm(2, xmm, RBP));
+    emit32(slotOffset(slot));
+}
+
+int32_t Assembler::slotOffset(int slot)
+{
+    // rbp - 8 holds the saved rbx
+    return -16 - slot * 8;
+}
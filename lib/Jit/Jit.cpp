@@ -0,0 +1,148 @@
+#include "./../../include/Jit/Jit.h"
+#include "./../../include/Jit/JitCompiler.h"
+#include "./../../include/Interpreter/Environment.h"
+#include "./../../include/Interpreter/LoxFunction.h"
+
+#ifdef LOX_JIT_SUPPORTED
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+JitFunction::JitFunction()
+{
+    this->entry = nullptr;
+    this->memory = nullptr;
+    this->size = 0;
+    this->bailouts = 0;
+}
+
+Jit::Jit(Environment* globals)
+{
+    this->enabled = true;
+    this->globals = globals;
+    this->functions = new std::unordered_map<Stmt::Function*, JitFunction*>();
+}
+
+JitFunction* Jit::compile(Stmt::Function* declaration)
+{
+    std::unordered_map<Stmt::Function*, JitFunction*>::iterator found = functions->find(declaration);
+
+    if (found != functions->end()) {
+        return found->second;
+    }
+
+    // Code lives as long as the declaration does, for the whole session
+    JitFunction* function = new JitFunction();
+    (*functions)[declaration] = function;
+
+#ifdef LOX_JIT_SUPPORTED
+    JitCompiler compiler(this);
+    std::vector<uint8_t> code;
+
+    if (compiler.compile(declaration, function, &code)) {
+        install(function, code);
+    }
+#endif
+
+    return function;
+}
+
+bool Jit::run(JitFunction* function, ArgumentSpan arguments, int depth, Value* result)
+{
+    // Too deep a call is reported by the interpreter
+    if (function->entry == nullptr
+        || function->bailouts >= MAX_BAILOUTS
+        || depth >= LoxCallable::MAX_CALL_DEPTH
+    ) {
+        return false;
+    }
+
+    // Compiled code assumes its parameters hold numbers
+    double numbers[256];
+    for (std::size_t i = 0; i < arguments.size(); i++) {
+        if (!arguments[i].isNumber()) {
+            return false;
+        }
+
+        numbers[i] = arguments[i].asNumber();
+    }
+
+    JitContext context;
+    context.bailout = 0;
+    // Compiled calls count towards the same limit as interpreted ones
+    context.depth = depth + 1;
+    context.jit = this;
+
+    double number = function->entry(numbers, &context);
+
+    // Nothing happened that running the call again could repeat
+    if (context.bailout) {
+        function->bailouts++;
+        return false;
+    }
+
+    *result = Value::fromNumber(number);
+
+    return true;
+}
+
+double Jit::call(JitContext* context, JitCallSite* site, double* arguments)
+{
+    Jit* jit = context->jit;
+    Value callee;
+
+    if (!jit->globals->tryGet(site->globalSlot, &callee) || !callee.isObjectType(OBJ_FUNCTION)) {
+        context->bailout = 1;
+        return 0;
+    }
+
+    LoxFunction* function = static_cast<LoxFunction*>(callee.asObject());
+
+    if (function->declaration != site->declaration) {
+        site->declaration = function->declaration;
+        site->function = jit->compile(function->declaration);
+    }
+
+    JitFunction* code = site->function;
+
+    if (code->entry == nullptr
+        || code->bailouts >= MAX_BAILOUTS
+        || function->arity() != site->argCount
+        || context->depth >= LoxCallable::MAX_CALL_DEPTH
+    ) {
+        context->bailout = 1;
+        return 0;
+    }
+
+    context->depth++;
+    double result = code->entry(arguments, context);
+    context->depth--;
+
+    return result;
+}
+
+void Jit::install(JitFunction* function, const std::vector<uint8_t>& code)
+{
+#ifdef LOX_JIT_SUPPORTED
+    std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    std::size_t size = (code.size() + pageSize - 1) / pageSize * pageSize;
+
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return;
+    }
+
+    std::memcpy(memory, code.data(), code.size());
+
+    // Pages are never writable and executable at once
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, size);
+        return;
+    }
+
+    function->memory = memory;
+    function->size = size;
+    function->entry = (JitEntry)memory;
+#endif
+}
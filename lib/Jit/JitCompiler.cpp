@@ -0,0 +1,401 @@
+#include "./../../include/Jit/JitCompiler.h"
+#include "./../../include/Interpreter/Environment.h"
+
+JitCompiler::JitCompiler(Jit* jit)
+{
+    this->jit = jit;
+    this->function = nullptr;
+    this->localCount = 0;
+    this->slotCount = 0;
+    this->type = JitType::JIT_NUMBER;
+    this->supported = true;
+}
+
+bool JitCompiler::compile(Stmt::Function* declaration, JitFunction* function, std::vector<uint8_t>* code)
+{
+    this->function = function;
+    this->slotCount = declaration->slotCount;
+
+    int frameSize = assembler.prologue();
+
+    // Parameters occupy the first slots of the frame
+    for (unsigned int i = 0; i < declaration->params->size(); i++) {
+        assembler.loadArgument(i, declareLocal());
+    }
+
+    for (Stmt::Stmt* stmt: *declaration->body) {
+        compile(stmt);
+    }
+
+    if (!supported) {
+        return false;
+    }
+
+    // Falling off the end returns nil, which only the interpreter can
+    assembler.setBailout();
+
+    for (int exit: exits) {
+        assembler.patchJump(exit);
+    }
+
+    assembler.epilogue();
+    assembler.patchFrameSize(frameSize, slotCount);
+
+    *code = assembler.code;
+
+    return true;
+}
+
+std::string* JitCompiler::visitAssignExpr(Expr::Assign* expr)
+{
+    int slot = resolveLocal(expr->kind, expr->slot);
+
+    if (slot < 0) {
+        unsupported();
+        return nullptr;
+    }
+
+    compileNumber(expr->value);
+    assembler.storeSlot(slot);
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitBinaryExpr(Expr::Binary* expr)
+{
+    TokenType operator_ = expr->operator_->type;
+
+    bool isArithmetic = operator_ == PLUS || operator_ == MINUS || operator_ == STAR || operator_ == SLASH;
+    bool isComparison = operator_ == GREATER || operator_ == GREATER_EQUAL
+        || operator_ == LESS || operator_ == LESS_EQUAL
+        || operator_ == EQUAL_EQUAL || operator_ == BANG_EQUAL;
+
+    if (!isArithmetic && !isComparison) {
+        unsupported();
+        return nullptr;
+    }
+
+    // Left operand waits in a temporary while the right one is computed
+    compileNumber(expr->left);
+    int left = allocateTemporary();
+    assembler.storeSlot(left);
+
+    compileNumber(expr->right);
+    assembler.loadLeftOperand(left);
+    releaseTemporary(left);
+
+    if (isArithmetic) {
+        assembler.arithmetic(operator_);
+        type = JitType::JIT_NUMBER;
+    } else {
+        assembler.compare(operator_);
+        type = JitType::JIT_BOOL;
+    }
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitCallExpr(Expr::Call* expr)
+{
+    Expr::Variable* callee = dynamic_cast<Expr::Variable*>(expr->callee);
+
+    if (expr->method != nullptr || callee == nullptr || callee->kind != Expr::VARIABLE_GLOBAL) {
+        unsupported();
+        return nullptr;
+    }
+
+    JitCallSite* site = new JitCallSite();
+    site->globalSlot = jit->globals->globalSlot(callee->name->interned);
+    site->argCount = expr->arguments->size();
+    site->declaration = nullptr;
+    site->function = nullptr;
+    function->callSites.push_back(site);
+
+    // Arguements are stored backwards so the first one has the lowest address
+    int argCount = expr->arguments->size();
+    int first = slotCount + argCount - 1;
+    slotCount += argCount;
+
+    for (int i = 0; i < argCount; i++) {
+        compileNumber(expr->arguments->at(i));
+        assembler.storeSlot(first - i);
+    }
+
+    assembler.callHelper((void*)&Jit::call, site, first);
+    exits.push_back(assembler.jumpIfBailout());
+
+    type = JitType::JIT_NUMBER;
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitGetExpr(Expr::Get* expr)
+{
+    unsupported();
+    return nullptr;
+}
+
+std::string* JitCompiler::visitGroupingExpr(Expr::Grouping* expr)
+{
+    compile(expr->expression);
+    return nullptr;
+}
+
+std::string* JitCompiler::visitLiteralExpr(Expr::Literal* expr)
+{
+    if (expr->value.isNumber()) {
+        assembler.loadNumber(expr->value.asNumber());
+        type = JitType::JIT_NUMBER;
+    } else if (expr->value.isBool()) {
+        assembler.loadBool(expr->value.asBool());
+        type = JitType::JIT_BOOL;
+    } else {
+        unsupported();
+    }
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitLogicalExpr(Expr::Logical* expr)
+{
+    // Only booleans, since otherwise the result would be one of the operands
+    compile(expr->left);
+    if (type != JitType::JIT_BOOL) {
+        unsupported();
+        return nullptr;
+    }
+
+    int shortCircuit = expr->operator_->type == AND
+        ? assembler.jumpIfFalse()
+        : assembler.jumpIfTrue();
+
+    compile(expr->right);
+    if (type != JitType::JIT_BOOL) {
+        unsupported();
+        return nullptr;
+    }
+
+    assembler.patchJump(shortCircuit);
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitUnaryExpr(Expr::Unary* expr)
+{
+    if (expr->operator_->type == MINUS) {
+        compileNumber(expr->right);
+        assembler.negate();
+        return nullptr;
+    }
+
+    compile(expr->right);
+    if (type != JitType::JIT_BOOL) {
+        unsupported();
+        return nullptr;
+    }
+
+    assembler.not_();
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitVariableExpr(Expr::Variable* expr)
+{
+    int slot = resolveLocal(expr->kind, expr->slot);
+
+    if (slot < 0) {
+        unsupported();
+        return nullptr;
+    }
+
+    assembler.loadSlot(slot);
+    type = JitType::JIT_NUMBER;
+
+    return nullptr;
+}
+
+std::string* JitCompiler::visitSetExpr(Expr::Set* expr)
+{
+    unsupported();
+    return nullptr;
+}
+
+std::string* JitCompiler::visitThisExpr(Expr::This* expr)
+{
+    unsupported();
+    return nullptr;
+}
+
+void* JitCompiler::visitBlockStmt(Stmt::Block* stmt)
+{
+    // Slots of the block's locals are reused after it, like the resolver does
+    int locals = localCount;
+
+    for (Stmt::Stmt* statement: *stmt->statements) {
+        compile(statement);
+    }
+
+    localCount = locals;
+
+    return nullptr;
+}
+
+void* JitCompiler::visitClassStmt(Stmt::Class* stmt)
+{
+    unsupported();
+    return nullptr;
+}
+
+void* JitCompiler::visitExpressionStmt(Stmt::Expression* stmt)
+{
+    compile(stmt->expression);
+    return nullptr;
+}
+
+void* JitCompiler::visitFunctionStmt(Stmt::Function* stmt)
+{
+    unsupported();
+    return nullptr;
+}
+
+void* JitCompiler::visitIfStmt(Stmt::If* stmt)
+{
+    int elseJump = compileCondition(stmt->condition);
+
+    compile(stmt->thenBranch);
+
+    int endJump = -1;
+    if (stmt->elseBranch != nullptr) {
+        endJump = assembler.jump();
+    }
+
+    if (elseJump >= 0) {
+        assembler.patchJump(elseJump);
+    }
+
+    if (stmt->elseBranch != nullptr) {
+        compile(stmt->elseBranch);
+        assembler.patchJump(endJump);
+    }
+
+    return nullptr;
+}
+
+void* JitCompiler::visitPrintStmt(Stmt::Print* stmt)
+{
+    unsupported();
+    return nullptr;
+}
+
+void* JitCompiler::visitReturnStmt(Stmt::Return* stmt)
+{
+    // A bare return gives nil
+    if (stmt->value == nullptr) {
+        unsupported();
+        return nullptr;
+    }
+
+    compileNumber(stmt->value);
+    exits.push_back(assembler.jump());
+
+    return nullptr;
+}
+
+void* JitCompiler::visitVarStmt(Stmt::Var* stmt)
+{
+    if (stmt->initializer == nullptr) {
+        unsupported();
+        return nullptr;
+    }
+
+    compileNumber(stmt->initializer);
+    assembler.storeSlot(declareLocal());
+
+    return nullptr;
+}
+
+void* JitCompiler::visitWhileStmt(Stmt::While* stmt)
+{
+    int loopStart = assembler.size();
+    int exitJump = compileCondition(stmt->condition);
+
+    compile(stmt->body);
+    assembler.jumpBack(loopStart);
+
+    if (exitJump >= 0) {
+        assembler.patchJump(exitJump);
+    }
+
+    return nullptr;
+}
+
+void JitCompiler::compile(Stmt::Stmt* stmt)
+{
+    if (supported) {
+        stmt->accept(this);
+    }
+}
+
+void JitCompiler::compile(Expr::Expr* expr)
+{
+    if (supported) {
+        expr->accept(this);
+    }
+}
+
+void JitCompiler::compileNumber(Expr::Expr* expr)
+{
+    compile(expr);
+
+    if (type != JitType::JIT_NUMBER) {
+        unsupported();
+    }
+}
+
+int JitCompiler::compileCondition(Expr::Expr* condition)
+{
+    compile(condition);
+
+    if (!supported || type == JitType::JIT_NUMBER) {
+        return -1;
+    }
+
+    return assembler.jumpIfFalse();
+}
+
+void JitCompiler::unsupported()
+{
+    supported = false;
+}
+
+int JitCompiler::declareLocal()
+{
+    return localCount++;
+}
+
+int JitCompiler::resolveLocal(Expr::VariableKind kind, int slot)
+{
+    // Globals and cells may hold anything, not only numbers
+    if (kind != Expr::VARIABLE_LOCAL) {
+        return -1;
+    }
+
+    return slot;
+}
+
+int JitCompiler::allocateTemporary()
+{
+    if (freeTemporaries.empty()) {
+        return slotCount++;
+    }
+
+    int slot = freeTemporaries.back();
+    freeTemporaries.pop_back();
+
+    return slot;
+}
+
+void JitCompiler::releaseTemporary(int slot)
+{
+    freeTemporaries.push_back(slot);
+}
@@ -1,11 +1,32 @@
 #include "./../include/Lox.h"
 
+#include <pthread.h>
+
 bool Lox::hadError = false;
 bool Lox::hadRuntimeError = false;
 Interpreter* Lox::interpreter = new Interpreter();
+VM* Lox::vm = nullptr;
+ClosureCompiler* Lox::closureCompiler = nullptr;
+Optimizer* Lox::optimizer = new Optimizer();
+std::vector<LoadedProgram>* Lox::programs = new std::vector<LoadedProgram>();
+Output* Lox::output = new Output(new FileTarget());
+bool Lox::reportTimings = false;
+double Lox::loadMs = 0;
+double Lox::compileMs = 0;
+double Lox::runMs = 0;
+bool Lox::sourceMapped = false;
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
 
 void Lox::report(int line, std::string where, std::string message) 
 {
+    // Anything printed before the error has to show up before it
+    output->flush();
+
     std::cerr       << 
         "[line "    <<
         line        <<
@@ -23,63 +44,111 @@ void Lox::error(Token* token, std::string message)
     if (token->type == TokenType::EOF_) {
         report(token->line, " at end", message);
     } else {
-        report(token->line, " at '" + *(token->lexeme) + "'", message);
+        report(token->line, " at '" + token->lexeme() + "'", message);
     }
 }
 
 void Lox::runtimeError(RuntimeError error)
 {
+    output->flush();
     std::cerr << "[line " << error.token->line << "] " << error.what() << std::endl;
 
     hadRuntimeError = true;
 }
 
+void Lox::runtimeError(int line, std::string message)
+{
+    output->flush();
+    std::cerr << "[line " << line << "] " << message << std::endl;
+
+    hadRuntimeError = true;
+}
+
 void Lox::error(int line, std::string message) 
 {
     report(line, "", message);
 }
 
-void Lox::run(std::string* srcCode) 
+void Lox::run(std::unique_ptr<const Source> source) 
 {
-    Scanner* scanner = new Scanner(srcCode);
-    std::vector<Token*>* tokens = scanner->scanTokens();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Everything made for this run is freed when it returns,
+    // unless it is moved into programs below
+    Scanner scanner(source.get());
+    std::unique_ptr<std::vector<Token>> tokens(scanner.scanTokens());
     
-    Parser* parser = new Parser(tokens);
-    std::vector<Stmt::Stmt*>* statements = parser->parse();
+    std::unique_ptr<Arena> arena(new Arena());
+
+    Parser parser(tokens.get(), arena.get());
+    NodeList<Stmt::Stmt*>* statements = parser.parse();
 
     if (hadError) {
+        // Nothing refers to a tree that never runs
+        compileMs += millisecondsSince(start);
         return;
     }
     
     // Resolver add a pass to source code for analysis 
     // which could generate warnings too
-    Resolver* resolver = new Resolver(interpreter);
-    resolver->resolve(statements);
+    Resolver resolver(interpreter, arena.get());
+    resolver.resolve(statements);
 
     if (hadError) {
+        compileMs += millisecondsSince(start);
         return;
     }
 
+    optimizer->optimize(statements, arena.get());
+
+    compileMs += millisecondsSince(start);
+    start = std::chrono::steady_clock::now();
+
     // if (Lox::hadRuntimeError) {
     //     return;
     // }
 
-    interpreter->interpret(statements);
+    if (vm != nullptr) {
+        vm->interpret(statements);
+    } else if (closureCompiler != nullptr) {
+        closureCompiler->interpret(statements);
+    } else {
+        interpreter->interpret(statements);
+    }
+
+    runMs += millisecondsSince(start);
+
+    // Functions and classes point to their declarations, and through
+    // their tokens to the source, for as long as they can be called
+    if (resolver.declaresFunctions) {
+        LoadedProgram program;
+        program.source = std::move(source);
+        program.tokens = std::move(tokens);
+        program.arena = std::move(arena);
+
+        programs->push_back(std::move(program));
+    }
 }
 
 void Lox::runFile(char* filepath) 
 {
     Lox::hadError = false;
 
-    std::ifstream file(filepath);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // Scripts are mapped instead of copied, the scanner reads the file itself
+    std::string error;
+    std::unique_ptr<Source> source(Source::load(filepath, &error));
 
-    if (file) {
-        std::ostringstream buffer;
-        buffer << file.rdbuf();
+    if (source) {
+        loadMs = millisecondsSince(start);
+        sourceMapped = source->isMapped();
 
-        std::string content = buffer.str();
+        run(std::move(source));
 
-        run(&content);
+        // Also stops the writer thread before exiting
+        output->close();
+        reportStats();
 
         if (Lox::hadError) {
             exit(1);
@@ -88,6 +157,9 @@ void Lox::runFile(char* filepath)
         if (Lox::hadRuntimeError) {
             exit(1);
         }
+    } else {
+        std::cerr << error << std::endl;
+        exit(1);
     }
 
 }
@@ -99,15 +171,71 @@ void Lox::runPrompt()
     std::string line;
 
     while (true) {
-        std::cout << "> ";
+        output->write("> ", 2);
+        output->flush();
         std::getline(std::cin, line);
 
         if (line.size() == 0) {
             break;
         }
 
-        run(&line);
+        // Functions declared on this line outlive it in the REPL
+        run(std::unique_ptr<const Source>(new Source(line)));
         hadError = false;
     }
 
+    output->close();
+    reportStats();
+
+}
+
+static void* runSessionThread(void* script)
+{
+    if (script != nullptr) {
+        // If File path is provided
+        Lox::runFile(static_cast<char*>(script));
+    } else {
+        // Running an Interactive Console - REPL
+        Lox::runPrompt();
+    }
+
+    return nullptr;
+}
+
+void Lox::runSession(char* script)
+{
+    // The main thread's stack is fixed by the environment, usually 8 MB
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setstacksize(&attributes, STACK_SIZE);
+
+    pthread_t thread;
+    bool started = pthread_create(&thread, &attributes, runSessionThread, script) == 0;
+    pthread_attr_destroy(&attributes);
+
+    if (started) {
+        pthread_join(thread, nullptr);
+    } else {
+        runSessionThread(script);
+    }
+}
+
+void Lox::reportStats()
+{
+    Heap* heap = vm != nullptr ? vm->heap : interpreter->heap;
+
+    if (heap->reportStats) {
+        heap->printStats(std::cerr);
+    }
+
+    if (optimizer->reportStats) {
+        optimizer->printStats(std::cerr);
+    }
+
+    if (reportTimings) {
+        std::cerr << "[timings] load: " << loadMs << " ms"
+                  << (sourceMapped ? " (mapped)" : " (read)")
+                  << ", compile: " << compileMs << " ms"
+                  << ", run: " << runMs << " ms" << std::endl;
+    }
 }
@@ -1,16 +1,32 @@
 #include "./../../include/Native/Clock.h"
 
+Clock::Clock() : LoxCallable(ObjectType::OBJ_NATIVE)
+{
+
+}
+
 unsigned int Clock::arity()
 {
     return 0;
 }
 
-std::string* Clock::call(Interpreter* interpreter, std::vector<std::string*>* arguements)
+Value Clock::call(Interpreter* interpreter, ArgumentSpan arguements)
+{
+    // Seconds since epoch with sub second precision so scripts can time themselves
+    std::chrono::duration<double> now = 
+        std::chrono::system_clock::now().time_since_epoch();
+
+    return Value::fromNumber(now.count());
+}
+
+std::string Clock::toString()
 {
-    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
+    return "<native fn>";
+}
 
-    return new std::string(std::to_string(now_c));
+std::size_t Clock::size()
+{
+    return sizeof(Clock);
 }
 
 std::ostream& operator<<(std::ostream& os, const Clock& t) {
@@ -0,0 +1,29 @@
+#include "./../../include/Native/Flush.h"
+#include "./../../include/Lox.h"
+
+Flush::Flush() : LoxCallable(ObjectType::OBJ_NATIVE)
+{
+
+}
+
+unsigned int Flush::arity()
+{
+    return 0;
+}
+
+Value Flush::call(Interpreter* interpreter, ArgumentSpan arguements)
+{
+    Lox::output->flush();
+
+    return Value();
+}
+
+std::string Flush::toString()
+{
+    return "<native fn>";
+}
+
+std::size_t Flush::size()
+{
+    return sizeof(Flush);
+}
@@ -0,0 +1,154 @@
+#include "./../../include/Output/Output.h"
+#include "./../../include/Interpreter/LoxString.h"
+#include "./../../include/Interpreter/NumberFormatter.h"
+
+Output::Output(OutputTarget* target, std::size_t capacity)
+{
+    this->target = target;
+    this->capacity = capacity;
+    this->buffer.reserve(capacity);
+    this->writer = nullptr;
+    this->hasPending = false;
+    this->writing = false;
+    this->stopping = false;
+}
+
+void Output::startWriter()
+{
+    if (writer == nullptr) {
+        pending.reserve(capacity);
+        writer = new std::thread(&Output::runWriter, this);
+    }
+}
+
+void Output::setTarget(OutputTarget* target)
+{
+    flush();
+
+    OutputTarget* previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        previous = this->target;
+        this->target = target;
+    }
+
+    // Writer is idle after the flush, nothing uses the previous target anymore
+    delete previous;
+}
+
+void Output::print(Value value)
+{
+    // Strings and numbers are copied into the buffer without a temporary string
+    if (value.isString()) {
+        const std::string& text = value.asString()->text();
+        buffer.append(text);
+    } else if (value.isNumber()) {
+        char number[NumberFormatter::MAX_LENGTH];
+        buffer.append(number, NumberFormatter::format(value.asNumber(), number));
+    } else {
+        buffer.append(value.toString());
+    }
+
+    buffer.push_back('\n');
+
+    if (buffer.size() >= capacity) {
+        drain();
+    }
+}
+
+void Output::write(const char* data, std::size_t length)
+{
+    buffer.append(data, length);
+
+    if (buffer.size() >= capacity) {
+        drain();
+    }
+}
+
+void Output::flush()
+{
+    drain();
+
+    if (writer != nullptr) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return !hasPending && !writing; });
+    }
+}
+
+void Output::close()
+{
+    flush();
+
+    if (writer == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+
+    writer->join();
+    delete writer;
+
+    writer = nullptr;
+    stopping = false;
+}
+
+void Output::drain()
+{
+    if (buffer.empty()) {
+        return;
+    }
+
+    if (writer == nullptr) {
+        target->write(buffer.data(), buffer.size());
+        buffer.clear();
+        return;
+    }
+
+    // Waits for the writer to take the previous buffer, then hands it this one
+    // Buffers are swapped around, so none is allocated again
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return !hasPending; });
+
+    pending.swap(buffer);
+    buffer.clear();
+    hasPending = true;
+
+    lock.unlock();
+    changed.notify_all();
+}
+
+void Output::runWriter()
+{
+    std::string chunk;
+    chunk.reserve(capacity);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this]() { return hasPending || stopping; });
+
+            if (!hasPending) {
+                return;
+            }
+
+            chunk.swap(pending);
+            hasPending = false;
+            writing = true;
+        }
+        changed.notify_all();
+
+        // Target is only written outside the lock, the interpreter keeps filling its buffer
+        target->write(chunk.data(), chunk.size());
+        chunk.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writing = false;
+        }
+        changed.notify_all();
+    }
+}
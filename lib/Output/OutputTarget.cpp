@@ -0,0 +1,59 @@
+#include "./../../include/Output/OutputTarget.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+OutputTarget::~OutputTarget()
+{
+
+}
+
+FileTarget::FileTarget()
+{
+    this->fd = STDOUT_FILENO;
+    this->ownsFd = false;
+}
+
+FileTarget::FileTarget(const std::string& path, std::string* error)
+{
+    this->fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    this->ownsFd = fd >= 0;
+
+    if (fd < 0) {
+        *error = "Could not open '" + path + "': " + std::strerror(errno);
+    }
+}
+
+FileTarget::~FileTarget()
+{
+    if (ownsFd) {
+        ::close(fd);
+    }
+}
+
+void FileTarget::write(const char* data, std::size_t length)
+{
+    // A write can be partial, eg: on pipes, or interrupted by a signal
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Nowhere left to report it, eg: the reading end of a pipe closed
+            return;
+        }
+
+        data += written;
+        length -= written;
+    }
+}
+
+void MemoryTarget::write(const char* data, std::size_t length)
+{
+    contents.append(data, length);
+}
@@ -0,0 +1,40 @@
+#include "./../../include/Parser/Arena.h"
+
+Arena::Arena()
+{
+    this->blocks = new std::vector<char*>();
+    this->current = nullptr;
+    this->remaining = 0;
+}
+
+Arena::~Arena()
+{
+    for (char* block: *blocks) {
+        delete[] block;
+    }
+
+    delete blocks;
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::size_t padding = (alignment - (reinterpret_cast<std::size_t>(current) % alignment)) % alignment;
+
+    if (current == nullptr || padding + size > remaining) {
+        // Oversized requests get a block of their own
+        std::size_t blockSize = size + alignment > BLOCK_SIZE ? size + alignment : BLOCK_SIZE;
+
+        current = new char[blockSize];
+        remaining = blockSize;
+        blocks->push_back(current);
+
+        padding = (alignment - (reinterpret_cast<std::size_t>(current) % alignment)) % alignment;
+    }
+
+    void* memory = current + padding;
+
+    current += padding + size;
+    remaining -= padding + size;
+
+    return memory;
+}
@@ -26,7 +26,7 @@ std::string* AstPrinter::visitBinaryExpr(Expr::Binary* expr)
     exprs.push_back(expr->right);
 
     return parenthesize(
-        expr->operator_->lexeme, exprs
+        new std::string(expr->operator_->lexeme()), exprs
     );
 }
 
@@ -40,10 +40,7 @@ std::string* AstPrinter::visitGroupingExpr(Expr::Grouping* expr)
 
 std::string* AstPrinter::visitLiteralExpr(Expr::Literal* expr) 
 {
-    if (expr->value->size() == 0) {
-        return new std::string("nil");
-    }
-    return expr->value;
+    return new std::string(expr->value.toString());
 
 }
 
@@ -52,5 +49,5 @@ std::string* AstPrinter::visitUnaryExpr(Expr::Unary* expr)
     std::vector<Expr::Expr*> exprs;
     exprs.push_back(expr->right);
 
-    return parenthesize(expr->operator_->lexeme, exprs);
+    return parenthesize(new std::string(expr->operator_->lexeme()), exprs);
 }
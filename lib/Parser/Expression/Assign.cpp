@@ -4,9 +4,16 @@ Expr::Assign::Assign(Token* name, Expr* value)
 {
     this->name = name;
     this->value = value;
+    this->kind = VARIABLE_GLOBAL;
+    this->slot = UNCACHED_SLOT;
 }
 
 std::string* Expr::Assign::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitAssignExpr(this);
+}
+
+Value Expr::Assign::accept(Visitor<Value>* visitor)
 {
     return visitor->visitAssignExpr(this);
 }
\ No newline at end of file
@@ -5,9 +5,15 @@ Expr::Binary::Binary(Expr* left, Token* operator_, Expr* right)
     this->left = left;
     this->operator_ = operator_;
     this->right = right;
+    this->specialization = BINARY_UNSPECIALIZED;
 }
 
 std::string* Expr::Binary::accept(Visitor<std::string*>* visitor)
 {
     return visitor->visitBinaryExpr(this);
 }
+
+Value Expr::Binary::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitBinaryExpr(this);
+}
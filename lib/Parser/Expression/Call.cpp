@@ -1,13 +1,22 @@
 #include "./../../../include/Parser/Expression/Call.h"
 
-Expr::Call::Call(Expr* callee, Token* paren, std::vector<Expr*>* arguments)
+Expr::Call::Call(Expr* callee, Token* paren, NodeList<Expr*>* arguments)
 {
     this->callee = callee;
     this->paren = paren;
     this->arguments = arguments;
+
+    this->method = dynamic_cast<Get*>(callee);
+    this->methodCacheCount = 0;
+    this->tailCall = false;
 }
 
 std::string* Expr::Call::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitCallExpr(this);
+}
+
+Value Expr::Call::accept(Visitor<Value>* visitor)
 {
     return visitor->visitCallExpr(this);
 }
\ No newline at end of file
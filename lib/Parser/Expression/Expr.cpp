@@ -4,3 +4,8 @@ std::string* Expr::Expr::accept(Visitor<std::string*>* visitor)
 {
     return new std::string("");
 }
+
+Value Expr::Expr::accept(Visitor<Value>* visitor)
+{
+    return Value();
+}
@@ -7,6 +7,11 @@ Expr::Get::Get(Expr* object, Token* name)
 }
 
 std::string* Expr::Get::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitGetExpr(this);
+}
+
+Value Expr::Get::accept(Visitor<Value>* visitor)
 {
     return visitor->visitGetExpr(this);
 }
\ No newline at end of file
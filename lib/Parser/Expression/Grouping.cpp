@@ -9,3 +9,8 @@ std::string* Expr::Grouping::accept(Visitor<std::string*>* visitor)
 {
     return visitor->visitGroupingExpr(this);
 }
+
+Value Expr::Grouping::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitGroupingExpr(this);
+}
@@ -1,6 +1,6 @@
 #include "./../../../include/Parser/Expression/Literal.h"      
                                                         
-Expr::Literal::Literal(std::string* value)               
+Expr::Literal::Literal(Value value)               
 {                                                      
     this->value = value;                                  
 };                                                     
@@ -9,3 +9,8 @@ std::string* Expr::Literal::accept(Visitor<std::string*>* visitor)
 {
     return visitor->visitLiteralExpr(this);
 }
+
+Value Expr::Literal::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitLiteralExpr(this);
+}
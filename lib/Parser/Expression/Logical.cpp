@@ -5,9 +5,15 @@ Expr::Logical::Logical(Expr* left, Token* operator_, Expr* right)
     this->left = left;
     this->operator_ = operator_;
     this->right = right;
+    this->specialization = LOGICAL_UNSPECIALIZED;
 }
 
 std::string* Expr::Logical::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitLogicalExpr(this);
+}
+
+Value Expr::Logical::accept(Visitor<Value>* visitor)
 {
     return visitor->visitLogicalExpr(this);
 }
\ No newline at end of file
@@ -8,6 +8,11 @@ Expr::Set::Set(Expr* object, Token* name, Expr* value)
 }
 
 std::string* Expr::Set::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitSetExpr(this);
+}
+
+Value Expr::Set::accept(Visitor<Value>* visitor)
 {
     return visitor->visitSetExpr(this);
 }
\ No newline at end of file
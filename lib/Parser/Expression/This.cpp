@@ -0,0 +1,18 @@
+#include "./../../../include/Parser/Expression/This.h"
+
+Expr::This::This(Token* keyword)
+{
+    this->keyword = keyword;
+    this->kind = VARIABLE_GLOBAL;
+    this->slot = UNCACHED_SLOT;
+}
+
+std::string* Expr::This::accept(Visitor<std::string*>* visitor)
+{
+    return visitor->visitThisExpr(this);
+}
+
+Value Expr::This::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitThisExpr(this);
+}
@@ -4,9 +4,15 @@ Expr::Unary::Unary(Token* operator_, Expr* right)
 {                                                      
     this->operator_ = operator_;
 	this->right = right;              
+    this->specialization = UNARY_UNSPECIALIZED;
 };                      
 
 std::string* Expr::Unary::accept(Visitor<std::string*>* visitor)
 {
     return visitor->visitUnaryExpr(this);    
 }
+
+Value Expr::Unary::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitUnaryExpr(this);
+}
@@ -3,9 +3,16 @@
 Expr::Variable::Variable(Token* name)               
 {                                                      
     this->name = name;                     
+    this->kind = VARIABLE_GLOBAL;
+    this->slot = UNCACHED_SLOT;
 };                                                     
 
 std::string* Expr::Variable::accept(Visitor<std::string*>* visitor)
 {
     return visitor->visitVariableExpr(this);
 }
+
+Value Expr::Variable::accept(Visitor<Value>* visitor)
+{
+    return visitor->visitVariableExpr(this);
+}
@@ -1,8 +1,9 @@
 #include "./../../include/Parser/Parser.h"
 
-Parser::Parser(std::vector<Token*>* tokens)
+Parser::Parser(std::vector<Token>* tokens, Arena* arena)
 {
     this->tokens = tokens;
+    this->arena = arena;
 }
 
 Expr::Expr* Parser::expression()
@@ -25,9 +26,9 @@ Expr::Expr* Parser::assignment()
         // Converting r-value expression to l-value representation
         if (Expr::Variable* e = dynamic_cast<Expr::Variable*>(expr)) {
             Token* name = e->name;
-            return new Expr::Assign(name, value);
+            return arena->make<Expr::Assign>(name, value);
         } else if (Expr::Get* get = dynamic_cast<Expr::Get*>(expr)) {
-            return new Expr::Set(get->object, get->name, value);
+            return arena->make<Expr::Set>(get->object, get->name, value);
         }
 
         // If l-value as expression isn't valid assigment target
@@ -51,7 +52,7 @@ Expr::Expr* Parser::or_()
         Token* operator_ = previous();
         Expr::Expr* right = and_();
 
-        expr = new Expr::Logical(expr, operator_, right);
+        expr = arena->make<Expr::Logical>(expr, operator_, right);
     }
 
     return expr;
@@ -65,30 +66,32 @@ Expr::Expr* Parser::and_()
         Token* operator_ = previous();
         Expr::Expr* right = equality();
 
-        expr = new Expr::Logical(expr, operator_, right);
+        expr = arena->make<Expr::Logical>(expr, operator_, right);
     }
 
     return expr;
 }
 
-std::vector<Stmt::Stmt*>* Parser::parse() 
+NodeList<Stmt::Stmt*>* Parser::parse() 
 {
-    std::vector<Stmt::Stmt*>* statements = new std::vector<Stmt::Stmt*>();
+    std::vector<Stmt::Stmt*> statements;
 
     while (!isAtEnd()) {
-        statements->push_back(declaration());
+        statements.push_back(declaration());
     }
 
-    return statements;
+    return arena->makeList(statements);
 }
 
 Expr::Expr* Parser::equality() 
 {
     Expr::Expr* expr = comparison();
 
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::BANG_EQUAL);
-    tokenTypes.push_back(TokenType::EQUAL_EQUAL);
+    // Static so the operator sets are not rebuilt for every expression parsed
+    static const std::vector<TokenType> tokenTypes = {
+        TokenType::BANG_EQUAL,
+        TokenType::EQUAL_EQUAL
+    };
 
     while (match(tokenTypes)) {
         Token* operator_ = previous(); // Since match() consumes current token
@@ -97,7 +100,7 @@ Expr::Expr* Parser::equality()
         // Since comparison will always happen between two operators
         // Making a left associative binary expression
         // By having the prev expr on the left side of the binary expr
-        expr = new Expr::Binary(expr, operator_, right);
+        expr = arena->make<Expr::Binary>(expr, operator_, right);
     }
 
     return expr;
@@ -107,17 +110,18 @@ Expr::Expr* Parser::comparison()
 {
     Expr::Expr* expr = term();
 
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::GREATER);
-    tokenTypes.push_back(TokenType::GREATER_EQUAL);
-    tokenTypes.push_back(TokenType::LESS);
-    tokenTypes.push_back(TokenType::LESS_EQUAL);
+    static const std::vector<TokenType> tokenTypes = {
+        TokenType::GREATER,
+        TokenType::GREATER_EQUAL,
+        TokenType::LESS,
+        TokenType::LESS_EQUAL
+    };
 
     while (match(tokenTypes)) {
         Token* operator_ = previous();
         Expr::Expr* right = term();
 
-        expr = new Expr::Binary(expr, operator_, right);
+        expr = arena->make<Expr::Binary>(expr, operator_, right);
     }
 
     return expr;
@@ -127,15 +131,16 @@ Expr::Expr* Parser::term()
 {
     Expr::Expr* expr = factor();
     
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::PLUS);
-    tokenTypes.push_back(TokenType::MINUS);
+    static const std::vector<TokenType> tokenTypes = {
+        TokenType::PLUS,
+        TokenType::MINUS
+    };
 
     while (match(tokenTypes)) {
         Token* operator_ = previous();
         Expr::Expr* right = factor();
 
-        expr = new Expr::Binary(expr, operator_, right);
+        expr = arena->make<Expr::Binary>(expr, operator_, right);
     }
 
     return expr;
@@ -146,15 +151,16 @@ Expr::Expr* Parser::factor()
 {
     Expr::Expr* expr = unary();
 
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::SLASH);
-    tokenTypes.push_back(TokenType::STAR);
+    static const std::vector<TokenType> tokenTypes = {
+        TokenType::SLASH,
+        TokenType::STAR
+    };
 
     while (match(tokenTypes)) {
         Token* operator_ = previous();
         Expr::Expr* right = unary();
 
-        expr = new Expr::Binary(expr, operator_, right);
+        expr = arena->make<Expr::Binary>(expr, operator_, right);
     }
 
     return expr;
@@ -163,15 +169,16 @@ Expr::Expr* Parser::factor()
 
 Expr::Expr* Parser::unary() 
 {
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::BANG);
-    tokenTypes.push_back(TokenType::BANG_EQUAL);
+    static const std::vector<TokenType> tokenTypes = {
+        TokenType::BANG,
+        TokenType::MINUS
+    };
 
     if (match(tokenTypes)) {
         Token* operator_ = previous();
         Expr::Expr* right = unary();
 
-        return new Expr::Unary(operator_, right);
+        return arena->make<Expr::Unary>(operator_, right);
     }
 
     return call();
@@ -192,7 +199,7 @@ Expr::Expr* Parser::call()
                 "Expect property name after '.'."
             );
 
-            expr = new Expr::Get(expr, name);
+            expr = arena->make<Expr::Get>(expr, name);
         } else {
             break;
         }
@@ -203,48 +210,56 @@ Expr::Expr* Parser::call()
 
 Expr::Expr* Parser::finishCall(Expr::Expr* callee)
 {
-    std::vector<Expr::Expr*>* arguements = new std::vector<Expr::Expr*>();
+    std::vector<Expr::Expr*> arguements;
 
     // Handling zero arguement case
     if (!check(TokenType::RIGHT_PAREN)) {
         // One arguement as expression required
         do {
-            if (arguements->size() >= 255) {
+            if (arguements.size() >= 255) {
                 error(peek(), "Can't have more than 255 arguments.");
             }
             
-            arguements->push_back(expression());
+            arguements.push_back(expression());
         } while (match(TokenType::COMMA));
     }
 
     Token* paren = consume(TokenType::RIGHT_PAREN, "Expect ')' after arguements.");
 
-    return new Expr::Call(callee, paren, arguements);
+    return arena->make<Expr::Call>(callee, paren, arena->makeList(arguements));
 }
 
 Expr::Expr* Parser::primary()
 {
-    if (match(TokenType::FALSE)) { return new Expr::Literal(new std::string("false")); }
-    if (match(TokenType::TRUE)) { return new Expr::Literal(new std::string("true")); }
-    if (match(TokenType::NIL)) { return new Expr::Literal(new std::string("nil")); }
+    if (match(TokenType::FALSE)) { return arena->make<Expr::Literal>(Value::fromBool(false)); }
+    if (match(TokenType::TRUE)) { return arena->make<Expr::Literal>(Value::fromBool(true)); }
+    if (match(TokenType::NIL)) { return arena->make<Expr::Literal>(Value()); }
 
-    std::vector<TokenType> tokenTypes;
-    tokenTypes.push_back(TokenType::NUMBER);
-    tokenTypes.push_back(TokenType::STRING);
+    // Literal text is converted once here so that the
+    // interpreter never parses numbers at runtime
+    if (match(TokenType::NUMBER)) {
+        return arena->make<Expr::Literal>(Value::fromNumber(
+            previous()->numberValue()
+        ));
+    }
 
-    if (match(tokenTypes)) {
-        return new Expr::Literal(previous()->literal);
+    if (match(TokenType::STRING)) {
+        return arena->make<Expr::Literal>(Value::fromObject(previous()->interned));
+    }
+
+    if (match(TokenType::THIS)) {
+        return arena->make<Expr::This>(previous());
     }
 
     if (match(TokenType::IDENTIFIER)) {
-        return new Expr::Variable(previous());
+        return arena->make<Expr::Variable>(previous());
     }
 
     if (match(TokenType::LEFT_PAREN)) {
         Expr::Expr* expr = expression();
         consume(TokenType::RIGHT_PAREN, "Expect ')' after expression.");
 
-        return new Expr::Grouping(expr);
+        return arena->make<Expr::Grouping>(expr);
     }
 
     // Token that cannot start an expression
@@ -280,7 +295,7 @@ Stmt::Stmt* Parser::statement()
     }
 
     if (match(TokenType::LEFT_BRACE)) {
-        return new Stmt::Block(block());
+        return arena->make<Stmt::Block>(block());
     }
 
     return expressionStatment();
@@ -291,7 +306,7 @@ Stmt::Stmt* Parser::printStatement()
     Expr::Expr* value = expression();
     consume(TokenType::SEMICOLON, "Expect ';' after value. ");
 
-    return new Stmt::Print(value);
+    return arena->make<Stmt::Print>(value);
 }
 
 Stmt::Stmt* Parser::expressionStatment()
@@ -299,7 +314,7 @@ Stmt::Stmt* Parser::expressionStatment()
     Expr::Expr* expr = expression();
     consume(TokenType::SEMICOLON, "Expect ';' after expression. ");
 
-    return new Stmt::Expression(expr);
+    return arena->make<Stmt::Expression>(expr);
 }
 
 Stmt::Stmt* Parser::ifStatement()
@@ -316,7 +331,7 @@ Stmt::Stmt* Parser::ifStatement()
         elseBranch = statement();
     }
 
-    return new Stmt::If(condition, thenBranch, elseBranch);
+    return arena->make<Stmt::If>(condition, thenBranch, elseBranch);
 }
 
 Stmt::Stmt* Parser::whileStatement()
@@ -327,7 +342,7 @@ Stmt::Stmt* Parser::whileStatement()
     consume(TokenType::RIGHT_PAREN, "Expect ')' after condition.");
     Stmt::Stmt* body = statement();
 
-    return new Stmt::While(condition, body);
+    return arena->make<Stmt::While>(condition, body);
 }
 
 Stmt::Stmt* Parser::forStatement()
@@ -371,47 +386,47 @@ Stmt::Stmt* Parser::forStatement()
 
     // Attaching increment at end of body if it exists
     if (increment != nullptr) {
-        std::vector<Stmt::Stmt*>* statements = new std::vector<Stmt::Stmt*>();
-        statements->push_back(body);
-        statements->push_back(new Stmt::Expression(increment));
+        std::vector<Stmt::Stmt*> statements;
+        statements.push_back(body);
+        statements.push_back(arena->make<Stmt::Expression>(increment));
 
-        body = new Stmt::Block(statements);
+        body = arena->make<Stmt::Block>(arena->makeList(statements));
     }
 
     // if no condition exists, set it as true
     if (condition == nullptr) {
-        condition = new Expr::Literal(new std::string("true"));
+        condition = arena->make<Expr::Literal>(Value::fromBool(true));
     }
 
     // Converting the parsed for loop in while loop using
     // initialization, condition and body combined with increment
-    body = new Stmt::While(condition, body);
+    body = arena->make<Stmt::While>(condition, body);
 
     // If initializer exist
     // We create a block with initilization as its first statement
     // The envrioment related to that block will automatically be handled
     // by interpreter
     if (initializer != nullptr) {
-        std::vector<Stmt::Stmt*>* statements = new std::vector<Stmt::Stmt*>();
-        statements->push_back(initializer);
-        statements->push_back(body);
+        std::vector<Stmt::Stmt*> statements;
+        statements.push_back(initializer);
+        statements.push_back(body);
 
-        body = new Stmt::Block(statements);
+        body = arena->make<Stmt::Block>(arena->makeList(statements));
     }
 
     return body;
 }
 
-std::vector<Stmt::Stmt*>* Parser::block()
+NodeList<Stmt::Stmt*>* Parser::block()
 {
-    std::vector<Stmt::Stmt*>* statements = new std::vector<Stmt::Stmt*>();
+    std::vector<Stmt::Stmt*> statements;
 
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        statements->push_back(declaration());
+        statements.push_back(declaration());
     }
 
     consume(TokenType::RIGHT_BRACE, "Expect '}' after block.");
-    return statements;
+    return arena->makeList(statements);
 }
 
 
@@ -431,9 +446,10 @@ Stmt::Stmt* Parser::declaration()
         }
 
         return statement();
-    } catch (ParseError error) {
+    } catch (ParseError* error) {
         // Parser goes into Panic mode and skips token
         // Till valid token is found
+        delete error;
         synchronize();
 
         return nullptr;
@@ -447,14 +463,14 @@ Stmt::Stmt* Parser::function(std::string kind)
 
     // Parsing the parameter list
     consume(TokenType::LEFT_PAREN, "Expect '(' after " + kind + " name.");
-    std::vector<Token*>* parameters = new std::vector<Token*>();
+    std::vector<Token*> parameters;
     if (!check(TokenType::RIGHT_PAREN)) {
         do {
-            if (parameters->size() >= 255) {
+            if (parameters.size() >= 255) {
                 error(peek(), "Can't have more than 255 parameters.");
             }
 
-            parameters->push_back(consume(
+            parameters.push_back(consume(
                 TokenType::IDENTIFIER, "Expect parameter name. "
             ));
         } while (match(TokenType::COMMA));
@@ -464,9 +480,9 @@ Stmt::Stmt* Parser::function(std::string kind)
 
     // Parsing Function Body
     consume(TokenType::LEFT_BRACE, "Expect '{' before " + kind + " body.");
-    std::vector<Stmt::Stmt*>* body = block();
+    NodeList<Stmt::Stmt*>* body = block();
 
-    return new Stmt::Function(name, parameters, body);
+    return arena->make<Stmt::Function>(name, arena->makeList(parameters), body);
 }
 
 Stmt::Stmt* Parser::varDeclaration()
@@ -480,7 +496,7 @@ Stmt::Stmt* Parser::varDeclaration()
 
     consume(TokenType::SEMICOLON, "Expect ';' after variable declaration");
 
-    return new Stmt::Var(name, initializer);
+    return arena->make<Stmt::Var>(name, initializer);
 }
 
 Stmt::Stmt* Parser::classDeclaration()
@@ -489,14 +505,14 @@ Stmt::Stmt* Parser::classDeclaration()
     
     consume(TokenType::LEFT_BRACE, "Expect '{' before class body.");
 
-    std::vector<Stmt::Function*>* methods = new std::vector<Stmt::Function*>();
+    std::vector<Stmt::Function*> methods;
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-        methods->push_back(static_cast<Stmt::Function*>(function("method")));
+        methods.push_back(static_cast<Stmt::Function*>(function("method")));
     }
 
     consume(TokenType::RIGHT_BRACE, "Expect '}' after class body.");
 
-    return new Stmt::Class(name, methods);
+    return arena->make<Stmt::Class>(name, arena->makeList(methods));
 }
 
 Stmt::Stmt* Parser::returnStatement()
@@ -510,10 +526,10 @@ Stmt::Stmt* Parser::returnStatement()
 
     consume(TokenType::SEMICOLON, "Expect ';' after return value.");
 
-    return new Stmt::Return(keyword, value);
+    return arena->make<Stmt::Return>(keyword, value);
 }
 
-bool Parser::match(std::vector<TokenType> tokenTypes)
+bool Parser::match(const std::vector<TokenType>& tokenTypes)
 {
     for (TokenType type : tokenTypes) {
         if (match(type)) {
@@ -546,7 +562,7 @@ bool Parser::check(TokenType type)
 // Return most recently consumed token
 Token* Parser::previous()
 {
-    return tokens->at(current - 1);
+    return &tokens->at(current - 1);
 }
 
 Token* Parser::advance()
@@ -566,7 +582,7 @@ bool Parser::isAtEnd()
 // return current token without consuming it
 Token* Parser::peek()
 {
-    return tokens->at(current);
+    return &tokens->at(current);
 }
 
 Token* Parser::consume(TokenType type, std::string message)
@@ -1,16 +1,17 @@
 #include "./../../../include/Parser/Stmt/Block.h"
 
-Stmt::Block::Block()
+Stmt::Block::Block(NodeList<Stmt*>* statements)
 {
-    this->statements = new std::vector<Stmt*>();
+    this->statements = statements;
+    this->localCount = 0;
 }
 
-Stmt::Block::Block(std::vector<Stmt*>* statements)
+void* Stmt::Block::accept(Visitor<void*>* visitor)
 {
-    this->statements = statements;
+    return visitor->visitBlockStmt(this);
 }
 
-void* Stmt::Block::accept(Visitor<void*>* visitor)
+Stmt::Completion Stmt::Block::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitBlockStmt(this);
 }
\ No newline at end of file
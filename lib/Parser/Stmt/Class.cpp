@@ -1,9 +1,10 @@
 #include "./../../../include/Parser/Stmt/Class.h"
 
-Stmt::Class::Class(Token* name, std::vector<Function*>* methods)
+Stmt::Class::Class(Token* name, NodeList<Function*>* methods)
 {
     this->name = name;
     this->methods = methods;
+    this->kind = Expr::VARIABLE_GLOBAL;
 }
 
 void* Stmt::Class::accept(Visitor<void*>* visitor)
@@ -11,3 +12,8 @@ void* Stmt::Class::accept(Visitor<void*>* visitor)
     return visitor->visitClassStmt(this);
 }
 
+Stmt::Completion Stmt::Class::accept(Visitor<Completion>* visitor)
+{
+    return visitor->visitClassStmt(this);
+}
+
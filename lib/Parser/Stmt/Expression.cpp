@@ -6,6 +6,11 @@ Stmt::Expression::Expression(Expr::Expr* expression)
 }
 
 void* Stmt::Expression::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitExpressionStmt(this);
+}
+
+Stmt::Completion Stmt::Expression::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitExpressionStmt(this);
 }
\ No newline at end of file
@@ -1,13 +1,23 @@
 #include "./../../../include/Parser/Stmt/Function.h"
 
-Stmt::Function::Function(Token* name, std::vector<Token*>* params, std::vector<Stmt*>* body)
+Stmt::Function::Function(Token* name, NodeList<Token*>* params, NodeList<Stmt*>* body)
 {
     this->name = name;
     this->params = params;
     this->body = body;
+
+    this->kind = Expr::VARIABLE_GLOBAL;
+    this->upvalues = nullptr;
+    this->cellParameters = nullptr;
+    this->slotCount = 0;
 }
 
 void* Stmt::Function::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitFunctionStmt(this);
+}
+
+Stmt::Completion Stmt::Function::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitFunctionStmt(this);
 }
\ No newline at end of file
@@ -8,6 +8,11 @@ Stmt::If::If(Expr::Expr* condition, Stmt* thenBranch, Stmt* elseBranch)
 }
 
 void* Stmt::If::accept(Visitor<void*>* visitor) 
+{
+    return visitor->visitIfStmt(this);
+}
+
+Stmt::Completion Stmt::If::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitIfStmt(this);
 }
\ No newline at end of file
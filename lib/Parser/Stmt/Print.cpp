@@ -6,6 +6,11 @@ Stmt::Print::Print(Expr::Expr* expression)
 }
 
 void* Stmt::Print::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitPrintStmt(this);
+}
+
+Stmt::Completion Stmt::Print::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitPrintStmt(this);
 }
\ No newline at end of file
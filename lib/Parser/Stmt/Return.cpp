@@ -7,6 +7,11 @@ Stmt::Return::Return(Token* keyword, Expr::Expr* value)
 }
 
 void* Stmt::Return::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitReturnStmt(this);
+}
+
+Stmt::Completion Stmt::Return::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitReturnStmt(this);
 }
\ No newline at end of file
@@ -4,3 +4,9 @@ void* Stmt::Stmt::accept(Visitor<void*>* visitor)
 {
     return nullptr;
 }
+
+
+Stmt::Completion Stmt::Stmt::accept(Visitor<Completion>* visitor)
+{
+    return COMPLETION_NORMAL;
+}
\ No newline at end of file
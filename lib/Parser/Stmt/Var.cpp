@@ -4,9 +4,15 @@ Stmt::Var::Var(Token* token, Expr::Expr* initializer)
 {
     this->name = token;
     this->initializer = initializer;
+    this->kind = Expr::VARIABLE_GLOBAL;
 }
 
 void* Stmt::Var::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitVarStmt(this);
+}
+
+Stmt::Completion Stmt::Var::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitVarStmt(this);
 }
\ No newline at end of file
@@ -7,6 +7,11 @@ Stmt::While::While(Expr::Expr* condition, Stmt* body)
 }
 
 void* Stmt::While::accept(Visitor<void*>* visitor)
+{
+    return visitor->visitWhileStmt(this);
+}
+
+Stmt::Completion Stmt::While::accept(Visitor<Completion>* visitor)
 {
     return visitor->visitWhileStmt(this);
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "./../../include/Scanner/Scanner.h"
 
-Scanner::Scanner(std::string* source) 
+#include <cstring>
+
+Scanner::Scanner(const Source* source) 
 {
     this->start = 0;
     this->current = 0;
@@ -8,35 +10,13 @@ Scanner::Scanner(std::string* source)
 
     this->source = source;
 
-    tokens = new std::vector<Token*>();
-
-    fillKeywords();
-}
-
-void Scanner::fillKeywords()
-{
-    keywords = new std::unordered_map<std::string, TokenType>();
-
-    (*keywords)["and"] = TokenType::AND;
-    (*keywords)["class"] = TokenType::CLASS;
-    (*keywords)["else"] = TokenType::ELSE;
-    (*keywords)["false"] = TokenType::FALSE;
-    (*keywords)["for"] = TokenType::FOR;
-    (*keywords)["fun"] = TokenType::FUN;
-    (*keywords)["if"] = TokenType::IF;
-    (*keywords)["nil"] = TokenType::NIL;
-    (*keywords)["or"] = TokenType::OR;
-    (*keywords)["print"] = TokenType::PRINT;
-    (*keywords)["return"] = TokenType::RETURN;
-    (*keywords)["super"] = TokenType::SUPER;
-    (*keywords)["this"] = TokenType::THIS;
-    (*keywords)["true"] = TokenType::TRUE;
-    (*keywords)["var"] = TokenType::VAR;
-    (*keywords)["while"] = TokenType::WHILE;
+    tokens = new std::vector<Token>();
 
+    // Roughly one token per 4 characters of source, avoids regrowing
+    tokens->reserve(source->length() / 4 + 1);
 }
 
-std::vector<Token*>* Scanner::scanTokens() 
+std::vector<Token>* Scanner::scanTokens() 
 {
     while (!isAtEnd()) {
 
@@ -45,19 +25,22 @@ std::vector<Token*>* Scanner::scanTokens()
     }
 
     // Adding End Of File
-    tokens->push_back(new Token(TokenType::EOF_, nullptr, nullptr, line));
+    tokens->push_back(Token(TokenType::EOF_, source, current, 0, line));
     return tokens;
 }
 
 void Scanner::addToken(TokenType type)
 {
-    addToken(type, nullptr);
-}
+    Token token(type, source, start, current - start, line);
 
-void Scanner::addToken(TokenType type, std::string* literal)
-{
-    std::string* text = new std::string(source->substr(start, current - start));
-    tokens->push_back(new Token(type, text, literal, line));
+    // Names are interned once here, later passes compare their addresses
+    if (type == TokenType::IDENTIFIER || type == TokenType::THIS) {
+        token.interned = StringTable::global()->intern(source->data() + start, current - start);
+    } else if (type == TokenType::STRING) {
+        token.interned = StringTable::global()->intern(source->data() + start + 1, current - start - 2);
+    }
+
+    tokens->push_back(token);
 }
 
 char Scanner::advance()
@@ -111,11 +94,19 @@ void Scanner::scanToken()
             } else if (match('*')) {
                 // Block comment support
                 // Block comments does not support nested blocks
-                while (peek() != '*' && peekNext() != '/' && !isAtEnd()) {
+                while (!(peek() == '*' && peekNext() == '/') && !isAtEnd()) {
                     if (advance() == '\n') {
                         line++;
                     }
                 }
+
+                // Mapped sources end without a terminator, nothing
+                // can be read past their last character
+                if (isAtEnd()) {
+                    Lox::error(line, "Unterminated block comment.");
+                    break;
+                }
+
                 // To handle last '*/'
                 advance(); advance();
             } else {
@@ -170,7 +161,7 @@ bool Scanner::match(char expected)
         return false;
     }
 
-    if (source->at(current) != expected) {
+    if ((*source)[current] != expected) {
         return false;
     }
 
@@ -188,7 +179,7 @@ char Scanner::peek()
     if (isAtEnd()) {
         return '\0';
     }
-    return source->at(current);
+    return (*source)[current];
 }
 
 char Scanner::peekNext()
@@ -197,7 +188,7 @@ char Scanner::peekNext()
         return '\0';
     }
 
-    return source->at(current + 1);
+    return (*source)[current + 1];
 }
 
 void Scanner::string()
@@ -220,11 +211,8 @@ void Scanner::string()
     // The closing "
     advance();
 
-    std::string* value = new std::string(
-        source->substr(start + 1, current - start - 2)
-    );
-
-    addToken(TokenType::STRING, value);
+    // Value without the quotes is taken from the lexeme by the parser
+    addToken(TokenType::STRING);
 }
 
 bool Scanner::isDigit(char c)
@@ -246,12 +234,59 @@ void Scanner::identifier()
         advance();
     }
 
-    std::string text = source->substr(start, current - start);
-    if (keywords->find(text) == keywords->end()) {
-        addToken(TokenType::IDENTIFIER);
-    } else {
-        addToken(keywords->at(text));
+    addToken(identifierType());
+}
+
+TokenType Scanner::identifierType()
+{
+    // Keywords are matched in place, a trie of switches on their letters
+    // so identifiers are never copied out of the source
+    switch ((*source)[start]) {
+        case 'a': return checkKeyword(1, "nd", TokenType::AND);
+        case 'c': return checkKeyword(1, "lass", TokenType::CLASS);
+        case 'e': return checkKeyword(1, "lse", TokenType::ELSE);
+        case 'f':
+            if (current - start > 1) {
+                switch ((*source)[start + 1]) {
+                    case 'a': return checkKeyword(2, "lse", TokenType::FALSE);
+                    case 'o': return checkKeyword(2, "r", TokenType::FOR);
+                    case 'u': return checkKeyword(2, "n", TokenType::FUN);
+                }
+            }
+            break;
+        case 'i': return checkKeyword(1, "f", TokenType::IF);
+        case 'n': return checkKeyword(1, "il", TokenType::NIL);
+        case 'o': return checkKeyword(1, "r", TokenType::OR);
+        case 'p': return checkKeyword(1, "rint", TokenType::PRINT);
+        case 'r': return checkKeyword(1, "eturn", TokenType::RETURN);
+        case 's': return checkKeyword(1, "uper", TokenType::SUPER);
+        case 't':
+            if (current - start > 1) {
+                switch ((*source)[start + 1]) {
+                    case 'h': return checkKeyword(2, "is", TokenType::THIS);
+                    case 'r': return checkKeyword(2, "ue", TokenType::TRUE);
+                }
+            }
+            break;
+        case 'v': return checkKeyword(1, "ar", TokenType::VAR);
+        case 'w': return checkKeyword(1, "hile", TokenType::WHILE);
+    }
+
+    return TokenType::IDENTIFIER;
+}
+
+TokenType Scanner::checkKeyword(int offset, const char* rest, TokenType type)
+{
+    int length = std::char_traits<char>::length(rest);
+
+    if (
+        current - start == offset + length &&
+        std::memcmp(source->data() + start + offset, rest, length) == 0
+    ) {
+        return type;
     }
+
+    return TokenType::IDENTIFIER;
 }
 
 bool Scanner::isAlphaNumeric(char c)
@@ -275,14 +310,8 @@ void Scanner::number()
         }
     }
 
-    // Since cpp doesnt support Object type to store 
-    // String and Number as Object only
-    // Number is also stored as string and will be later typecasted
-    addToken(TokenType::NUMBER, new std::string(
-        source->substr(start, current - start)
-    ));
-
-    
+    // Value is parsed from the lexeme by the parser
+    addToken(TokenType::NUMBER);
 }
 
 bool Scanner::isAtEnd()
@@ -0,0 +1,117 @@
+#include "./../../include/Scanner/Source.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Source::Source()
+{
+    this->bytes = nullptr;
+    this->size = 0;
+    this->mapping = nullptr;
+}
+
+Source::Source(const std::string& text)
+    : text(text)
+{
+    this->bytes = this->text.data();
+    this->size = this->text.length();
+    this->mapping = nullptr;
+}
+
+Source::Source(std::string&& text)
+    : text(std::move(text))
+{
+    this->bytes = this->text.data();
+    this->size = this->text.length();
+    this->mapping = nullptr;
+}
+
+Source::~Source()
+{
+    if (mapping != nullptr) {
+        ::munmap(mapping, size);
+    }
+}
+
+// Reads until end of file straight into the string, growing it as needed
+static bool readAll(int fd, std::size_t sizeHint, std::string* text)
+{
+    std::size_t used = 0;
+    text->resize(sizeHint > 0 ? sizeHint + 1 : 64 * 1024);
+
+    while (true) {
+        if (used == text->size()) {
+            text->resize(text->size() * 2);
+        }
+
+        ssize_t count = ::read(fd, &(*text)[used], text->size() - used);
+
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        if (count == 0) {
+            break;
+        }
+
+        used += count;
+    }
+
+    text->resize(used);
+    return true;
+}
+
+Source* Source::load(const std::string& path, std::string* error)
+{
+    bool isStdin = path == "-";
+    int fd = isStdin ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        *error = "Could not open '" + path + "': " + std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat status;
+    bool isRegular = ::fstat(fd, &status) == 0 && S_ISREG(status.st_mode);
+
+    Source* source = new Source();
+
+    // Empty files cant be mapped, they take the read path like pipes
+    if (isRegular && status.st_size > 0) {
+        void* mapping = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (mapping != MAP_FAILED) {
+            // The scanner reads it once from start to end
+            ::madvise(mapping, status.st_size, MADV_SEQUENTIAL);
+
+            source->mapping = mapping;
+            source->bytes = static_cast<const char*>(mapping);
+            source->size = status.st_size;
+        }
+    }
+
+    if (source->mapping == nullptr) {
+        if (!readAll(fd, isRegular ? status.st_size : 0, &source->text)) {
+            *error = "Could not read '" + path + "': " + std::strerror(errno);
+            delete source;
+            source = nullptr;
+        } else {
+            source->bytes = source->text.data();
+            source->size = source->text.length();
+        }
+    }
+
+    // A mapping stays valid once its descriptor is closed
+    if (!isStdin) {
+        ::close(fd);
+    }
+
+    return source;
+}
@@ -1,18 +1,53 @@
 #include "./../../include/Scanner/Token.h"
 
-Token::Token(TokenType type, std::string* lexeme, std::string* literal, int line) 
+#include <cstdlib>
+#include <cstring>
+
+Token::Token(TokenType type, const Source* source, int start, int length, int line) 
 {
     this->type = type;
-    this->lexeme = lexeme;
-    this->literal = literal;
+    this->source = source;
+    this->start = start;
+    this->length = length;
     this->line = line;
+    this->interned = nullptr;
 }
 
-std::ostream& operator<<(std::ostream& os, const Token& t) {
-    std::string lexemeStr = t.lexeme ? *(t.lexeme) : "";
-    std::string literalStr = t.literal ? *(t.literal) : "";
+std::string Token::lexeme() const
+{
+    return std::string(source->data() + start, length);
+}
 
-    os << std::to_string(t.type) + " " + lexemeStr + " " + literalStr;
-    return os;
+bool Token::lexemeEquals(const Token* other) const
+{
+    return  length == other->length &&
+            std::memcmp(source->data() + start, other->source->data() + other->start, length) == 0;
+}
+
+bool Token::lexemeEquals(const std::string& text) const
+{
+    return  (std::size_t)length == text.length() &&
+            std::memcmp(source->data() + start, text.data(), length) == 0;
 }
 
+double Token::numberValue() const
+{
+    // A mapped source has no terminator after its last token, so the
+    // lexeme is copied into one before strtod reads it
+    char digits[64];
+
+    if ((std::size_t)length >= sizeof(digits)) {
+        // Every digit changes the value, long literals are never cut
+        return std::strtod(lexeme().c_str(), nullptr);
+    }
+
+    std::memcpy(digits, source->data() + start, length);
+    digits[length] = '\0';
+
+    return std::strtod(digits, nullptr);
+}
+
+std::ostream& operator<<(std::ostream& os, const Token& t) {
+    os << std::to_string(t.type) + " " + t.lexeme();
+    return os;
+}
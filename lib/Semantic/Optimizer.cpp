@@ -0,0 +1,347 @@
+#include "./../../include/Semantic/Optimizer.h"
+#include "./../../include/Parser/Arena.h"
+#include "./../../include/Interpreter/StringTable.h"
+
+Optimizer::Optimizer()
+{
+    this->reportStats = false;
+    this->foldedNodes = 0;
+    this->prunedBranches = 0;
+    this->arena = nullptr;
+    this->optimizedExpr = nullptr;
+    this->replacedStmt = false;
+    this->optimizedStmt = nullptr;
+}
+
+void Optimizer::optimize(NodeList<Stmt::Stmt*>* statements, Arena* arena)
+{
+    this->arena = arena;
+    optimize(statements);
+}
+
+void Optimizer::printStats(std::ostream& os)
+{
+    os << "[opt] folded nodes: " << foldedNodes << std::endl;
+    os << "[opt] pruned branches: " << prunedBranches << std::endl;
+}
+
+std::string* Optimizer::visitAssignExpr(Expr::Assign* expr)
+{
+    expr->value = optimize(expr->value);
+    return nullptr;
+}
+
+std::string* Optimizer::visitBinaryExpr(Expr::Binary* expr)
+{
+    expr->left = optimize(expr->left);
+    expr->right = optimize(expr->right);
+
+    Expr::Literal* left = dynamic_cast<Expr::Literal*>(expr->left);
+    Expr::Literal* right = dynamic_cast<Expr::Literal*>(expr->right);
+
+    Value result;
+    if (left != nullptr && right != nullptr
+        && evaluateBinary(expr->operator_->type, left->value, right->value, &result)
+    ) {
+        fold(result);
+    }
+
+    return nullptr;
+}
+
+std::string* Optimizer::visitCallExpr(Expr::Call* expr)
+{
+    expr->callee = optimize(expr->callee);
+
+    for (Expr::Expr*& argument: *expr->arguments) {
+        argument = optimize(argument);
+    }
+
+    return nullptr;
+}
+
+std::string* Optimizer::visitGetExpr(Expr::Get* expr)
+{
+    expr->object = optimize(expr->object);
+    return nullptr;
+}
+
+std::string* Optimizer::visitGroupingExpr(Expr::Grouping* expr)
+{
+    expr->expression = optimize(expr->expression);
+
+    Expr::Literal* literal = dynamic_cast<Expr::Literal*>(expr->expression);
+    if (literal != nullptr) {
+        foldedNodes++;
+        optimizedExpr = literal;
+    }
+
+    return nullptr;
+}
+
+std::string* Optimizer::visitLiteralExpr(Expr::Literal* expr)
+{
+    return nullptr;
+}
+
+std::string* Optimizer::visitLogicalExpr(Expr::Logical* expr)
+{
+    expr->left = optimize(expr->left);
+    expr->right = optimize(expr->right);
+
+    Expr::Literal* left = dynamic_cast<Expr::Literal*>(expr->left);
+    if (left == nullptr) {
+        return nullptr;
+    }
+
+    // A constant left operand decides the short circuit, so the node
+    // is either that operand or the right one, constant or not
+    bool shortCircuits = expr->operator_->type == TokenType::OR
+        ? isTruthy(left->value)
+        : !isTruthy(left->value);
+
+    foldedNodes++;
+    optimizedExpr = shortCircuits ? expr->left : expr->right;
+
+    return nullptr;
+}
+
+std::string* Optimizer::visitUnaryExpr(Expr::Unary* expr)
+{
+    expr->right = optimize(expr->right);
+
+    Expr::Literal* right = dynamic_cast<Expr::Literal*>(expr->right);
+    if (right == nullptr) {
+        return nullptr;
+    }
+
+    if (expr->operator_->type == TokenType::BANG) {
+        fold(Value::fromBool(!isTruthy(right->value)));
+    } else if (right->value.isNumber()) {
+        fold(Value::fromNumber(-right->value.asNumber()));
+    }
+
+    return nullptr;
+}
+
+std::string* Optimizer::visitVariableExpr(Expr::Variable* expr)
+{
+    return nullptr;
+}
+
+std::string* Optimizer::visitSetExpr(Expr::Set* expr)
+{
+    expr->object = optimize(expr->object);
+    expr->value = optimize(expr->value);
+    return nullptr;
+}
+
+std::string* Optimizer::visitThisExpr(Expr::This* expr)
+{
+    return nullptr;
+}
+
+void* Optimizer::visitBlockStmt(Stmt::Block* stmt)
+{
+    optimize(stmt->statements);
+    return nullptr;
+}
+
+void* Optimizer::visitClassStmt(Stmt::Class* stmt)
+{
+    for (Stmt::Function* method: *stmt->methods) {
+        optimize(method->body);
+    }
+
+    return nullptr;
+}
+
+void* Optimizer::visitExpressionStmt(Stmt::Expression* stmt)
+{
+    stmt->expression = optimize(stmt->expression);
+    return nullptr;
+}
+
+void* Optimizer::visitFunctionStmt(Stmt::Function* stmt)
+{
+    optimize(stmt->body);
+    return nullptr;
+}
+
+void* Optimizer::visitIfStmt(Stmt::If* stmt)
+{
+    stmt->condition = optimize(stmt->condition);
+    stmt->thenBranch = optimize(stmt->thenBranch);
+    if (stmt->elseBranch != nullptr) {
+        stmt->elseBranch = optimize(stmt->elseBranch);
+    }
+
+    Expr::Literal* condition = dynamic_cast<Expr::Literal*>(stmt->condition);
+    if (condition == nullptr) {
+        return nullptr;
+    }
+
+    // Only the branch that always runs is kept, without the test
+    prunedBranches++;
+    replacedStmt = true;
+    optimizedStmt = isTruthy(condition->value) ? stmt->thenBranch : stmt->elseBranch;
+
+    return nullptr;
+}
+
+void* Optimizer::visitPrintStmt(Stmt::Print* stmt)
+{
+    stmt->expression = optimize(stmt->expression);
+    return nullptr;
+}
+
+void* Optimizer::visitReturnStmt(Stmt::Return* stmt)
+{
+    if (stmt->value != nullptr) {
+        stmt->value = optimize(stmt->value);
+    }
+
+    return nullptr;
+}
+
+void* Optimizer::visitVarStmt(Stmt::Var* stmt)
+{
+    if (stmt->initializer != nullptr) {
+        stmt->initializer = optimize(stmt->initializer);
+    }
+
+    return nullptr;
+}
+
+void* Optimizer::visitWhileStmt(Stmt::While* stmt)
+{
+    stmt->condition = optimize(stmt->condition);
+    stmt->body = optimize(stmt->body);
+
+    // Loops that never run are removed, infinite ones stay as they are
+    Expr::Literal* condition = dynamic_cast<Expr::Literal*>(stmt->condition);
+    if (condition != nullptr && !isTruthy(condition->value)) {
+        prunedBranches++;
+        replacedStmt = true;
+        optimizedStmt = nullptr;
+    }
+
+    return nullptr;
+}
+
+Expr::Expr* Optimizer::optimize(Expr::Expr* expr)
+{
+    // Children are visited first, so the replacement left
+    // once the visit ends is always the node's own
+    expr->accept(this);
+
+    Expr::Expr* replacement = optimizedExpr != nullptr ? optimizedExpr : expr;
+    optimizedExpr = nullptr;
+
+    return replacement;
+}
+
+Stmt::Stmt* Optimizer::optimize(Stmt::Stmt* stmt)
+{
+    stmt->accept(this);
+
+    if (!replacedStmt) {
+        return stmt;
+    }
+
+    Stmt::Stmt* replacement = optimizedStmt;
+    replacedStmt = false;
+
+    if (replacement == nullptr) {
+        return arena->make<Stmt::Block>(arena->makeList(std::vector<Stmt::Stmt*>()));
+    }
+
+    return replacement;
+}
+
+void Optimizer::optimize(NodeList<Stmt::Stmt*>* statements)
+{
+    // Kept statements are moved down over the removed ones
+    std::size_t kept = 0;
+
+    for (std::size_t i = 0; i < statements->size(); i++) {
+        Stmt::Stmt* statement = statements->at(i);
+        statement->accept(this);
+
+        if (replacedStmt) {
+            statement = optimizedStmt;
+            replacedStmt = false;
+        }
+
+        if (statement != nullptr) {
+            statements->at(kept++) = statement;
+        }
+    }
+
+    statements->count = kept;
+}
+
+void Optimizer::fold(Value value)
+{
+    foldedNodes++;
+    optimizedExpr = arena->make<Expr::Literal>(value);
+}
+
+bool Optimizer::evaluateBinary(TokenType operator_, Value left, Value right, Value* result)
+{
+    // Same rules as the backends at runtime
+    if (operator_ == TokenType::EQUAL_EQUAL) {
+        *result = Value::fromBool(left.equals(right));
+        return true;
+    }
+
+    if (operator_ == TokenType::BANG_EQUAL) {
+        *result = Value::fromBool(!left.equals(right));
+        return true;
+    }
+
+    // Like string literals, folded strings are interned
+    if (operator_ == TokenType::PLUS && !(left.isNumber() && right.isNumber())) {
+        if (!left.isString() && !right.isString()) {
+            return false;
+        }
+
+        *result = Value::fromObject(StringTable::global()->intern(left.toString() + right.toString()));
+        return true;
+    }
+
+    if (!left.isNumber() || !right.isNumber()) {
+        return false;
+    }
+
+    double a = left.asNumber();
+    double b = right.asNumber();
+
+    switch (operator_) {
+        case TokenType::PLUS: *result = Value::fromNumber(a + b); return true;
+        case TokenType::MINUS: *result = Value::fromNumber(a - b); return true;
+        case TokenType::STAR: *result = Value::fromNumber(a * b); return true;
+        case TokenType::SLASH: *result = Value::fromNumber(a / b); return true;
+        case TokenType::GREATER: *result = Value::fromBool(a > b); return true;
+        case TokenType::GREATER_EQUAL: *result = Value::fromBool(a >= b); return true;
+        case TokenType::LESS: *result = Value::fromBool(a < b); return true;
+        case TokenType::LESS_EQUAL: *result = Value::fromBool(a <= b); return true;
+
+        default:
+            return false;
+    }
+}
+
+bool Optimizer::isTruthy(Value value)
+{
+    // nil and false are falsey, everything else is truthy
+    if (value.isNil()) {
+        return false;
+    }
+
+    if (value.isBool()) {
+        return value.asBool();
+    }
+
+    return true;
+}
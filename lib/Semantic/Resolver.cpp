@@ -1,30 +1,59 @@
+#include <algorithm>
+
 #include "./../../include/Semantic/Resolver.h"
+#include "./../../include/Parser/Arena.h"
+#include "./../../include/Interpreter/StringTable.h"
 
-Resolver::Resolver(Interpreter* interpreter)
+Resolver::Resolver(Interpreter* interpreter, Arena* arena)
 {
     this->interpreter = interpreter;
+    this->arena = arena;
 
-    scopes = new std::stack<std::unordered_map<std::string, bool>*>();
+    scopes = new std::vector<std::unordered_map<LoxString*, LocalVariable>*>();
 
     this->currentFunction = FunctionType::NONE;
+    this->currentClass = ClassType::CLASS_NONE;
+
+    // Frame of the top level code, holding the locals of its blocks
+    this->function = new FunctionScope();
+    this->function->enclosing = nullptr;
+    this->function->firstScope = 0;
+    this->function->slotCount = 0;
+    this->function->maxSlots = 0;
+
+    this->declaresFunctions = false;
+}
+
+Resolver::~Resolver()
+{
+    for (std::unordered_map<LoxString*, LocalVariable>* scope: *scopes) {
+        delete scope;
+    }
+    delete scopes;
+
+    // Frames of functions live on the C++ stack, only the top level one is left
+    delete function;
 }
 
 
 std::string* Resolver::visitVariableExpr(Expr::Variable* expr)
 {
-    // if (
-    //     !scopes->empty() &&
-    //     scopes->top()->at(*expr->name->lexeme) == false
-    // ) {
-    //     // Variable is declared but have not been defined
-    //     // Therefore we throw an error
-    //     Lox::error(
-    //         expr->name,
-    //         "Can't read local variable in its own initializer."
-    //     );
-    // }
-
-    resolveLocal(expr, expr->name);
+    if (!scopes->empty()) {
+        std::unordered_map<LoxString*, LocalVariable>* scope = scopes->back();
+        std::unordered_map<LoxString*, LocalVariable>::iterator variable = 
+            scope->find(expr->name->interned);
+
+        if (variable != scope->end() && !variable->second.defined) {
+            // Variable is declared but have not been defined
+            // Its slot would be read before being filled, therefore we throw an error
+            Lox::error(
+                expr->name,
+                "Can't read local variable in its own initializer."
+            );
+        }
+    }
+
+    resolveLocal(expr->name, &expr->kind, &expr->slot);
     return nullptr;
 }
 
@@ -34,7 +63,7 @@ std::string* Resolver::visitAssignExpr(Expr::Assign* expr)
     resolve(expr->value);
 
     // resolve the variable thats being assigned to
-    resolveLocal(expr, expr->name);
+    resolveLocal(expr->name, &expr->kind, &expr->slot);
 
     return nullptr;
 }
@@ -79,6 +108,18 @@ std::string* Resolver::visitSetExpr(Expr::Set* expr)
     return nullptr;
 }
 
+std::string* Resolver::visitThisExpr(Expr::This* expr)
+{
+    if (currentClass == ClassType::CLASS_NONE) {
+        Lox::error(expr->keyword, "Can't use 'this' outside of a class.");
+        return nullptr;
+    }
+
+    // Resolved like any local, methods declare it in their scope
+    resolveLocal(expr->keyword, &expr->kind, &expr->slot);
+    return nullptr;
+}
+
 std::string* Resolver::visitGroupingExpr(Expr::Grouping* expr)
 {
     resolve(expr->expression);
@@ -113,9 +154,24 @@ std::string* Resolver::visitUnaryExpr(Expr::Unary* expr)
 
 void* Resolver::visitClassStmt(Stmt::Class* stmt)
 {
-    declare(stmt->name);
+    ClassType enclosingClass = currentClass;
+    currentClass = ClassType::CLASS_BODY;
+    declaresFunctions = true;
+
+    declare(stmt->name, &stmt->kind);
     define(stmt->name);
 
+    for (Stmt::Function* method: *stmt->methods) {
+        FunctionType type = FunctionType::METHOD;
+
+        if (method->name->lexemeEquals("init")) {
+            type = FunctionType::INITIALIZER;
+        }
+
+        resolveFunction(method, type);
+    }
+
+    currentClass = enclosingClass;
     return nullptr;
 }
 
@@ -152,6 +208,16 @@ void* Resolver::visitReturnStmt(Stmt::Return* stmt)
     }
 
     if (stmt->value != nullptr) {
+        if (currentFunction == FunctionType::INITIALIZER) {
+            Lox::error(stmt->keyword, "Can't return a value from an initializer.");
+        }
+
+        // Nothing is left to do in the frame once the callee returns
+        Expr::Call* call = dynamic_cast<Expr::Call*>(stmt->value);
+        if (call != nullptr && currentFunction != FunctionType::NONE) {
+            call->tailCall = true;
+        }
+
         resolve(stmt->value);
     }
 
@@ -170,7 +236,7 @@ void* Resolver::visitVarStmt(Stmt::Var* stmt)
 {
     // Binding done in two steps: Declaring and Defining 
 
-    declare(stmt->name);
+    declare(stmt->name, &stmt->kind);
     if (stmt->initializer != nullptr) {
         resolve(stmt->initializer);
     }
@@ -183,6 +249,7 @@ void* Resolver::visitBlockStmt(Stmt::Block* stmt)
 {
     beginScope();
     resolve(stmt->statements);
+    stmt->localCount = scopes->back()->size();
     endScope();
 
     return nullptr;
@@ -192,7 +259,7 @@ void* Resolver::visitFunctionStmt(Stmt::Function* stmt)
 {
     // We declare and define function first then resolve its body
     // to support recursion to refer itself
-    declare(stmt->name);
+    declare(stmt->name, &stmt->kind);
     define(stmt->name);
 
     resolveFunction(stmt, FunctionType::FUNCTION);
@@ -201,12 +268,16 @@ void* Resolver::visitFunctionStmt(Stmt::Function* stmt)
 
 void Resolver::beginScope()
 {
-    scopes->push(new std::unordered_map<std::string, bool>());
+    scopes->push_back(new std::unordered_map<LoxString*, LocalVariable>());
 }
 
 void Resolver::endScope()
 {
-    scopes->pop();
+    // Slots of the scope's locals are free for the next scope
+    function->slotCount -= scopes->back()->size();
+
+    delete scopes->back();
+    scopes->pop_back();
 }
 
 void Resolver::resolve(Stmt::Stmt* statement)
@@ -219,32 +290,68 @@ void Resolver::resolve(Expr::Expr* statement)
     statement->accept(this);
 }
 
-void Resolver::resolve(std::vector<Stmt::Stmt*>* statements)
+void Resolver::resolve(NodeList<Stmt::Stmt*>* statements)
 {
     for (Stmt::Stmt* statement: *statements) {
         resolve(statement);
     }
 }
 
-void Resolver::declare(Token* name)
+void Resolver::declare(Token* name, Expr::VariableKind* kind)
 {
     if (scopes->empty()) {
         return;
     }
 
-    std::unordered_map<std::string, bool>* scope = scopes->top();
+    std::unordered_map<LoxString*, LocalVariable>* scope = scopes->back();
 
     // If there is collision when declaring variable in local scope
     // We throw error
-    if (scope->find(*name->lexeme) != scope->end()) {
+    if (scope->find(name->interned) != scope->end()) {
         Lox::error(name,
             "Already variable with this name in this scope."
         );
+        return;
     }
 
-    // Boolean related to string represents whether the variable
-    // has finished resolving the initializer
-    (*scope)[*name->lexeme] = false;
+    LocalVariable* variable = addLocal(name->interned);
+
+    *kind = Expr::VARIABLE_LOCAL;
+    variable->kinds.push_back(kind);
+}
+
+void Resolver::declareParameter(Token* name)
+{
+    std::unordered_map<LoxString*, LocalVariable>* scope = scopes->back();
+
+    if (scope->find(name->interned) != scope->end()) {
+        Lox::error(name,
+            "Already variable with this name in this scope."
+        );
+        return;
+    }
+
+    LocalVariable* variable = addLocal(name->interned);
+    variable->isParameter = true;
+    variable->defined = true;
+}
+
+LocalVariable* Resolver::addLocal(LoxString* name)
+{
+    // Slots are numbered in declaration order, which is also the order
+    // the interpreter pushes locals on the frame
+    LocalVariable variable;
+    variable.slot = function->slotCount++;
+    variable.defined = false;
+    variable.isParameter = false;
+    variable.captured = false;
+
+    function->maxSlots = std::max(function->maxSlots, function->slotCount);
+
+    std::unordered_map<LoxString*, LocalVariable>* scope = scopes->back();
+    (*scope)[name] = variable;
+
+    return &(*scope)[name];
 }
 
 void Resolver::define(Token* name)
@@ -254,59 +361,136 @@ void Resolver::define(Token* name)
     }
 
     // Variable fully initialised and available for use
-    (*scopes->top())[*name->lexeme] = true;
-}
-
-void Resolver::resolveLocal(Expr::Expr* expr, Token* name)
-{
-    std::stack<std::unordered_map<std::string, bool>*>* tempScopes = 
-        new std::stack<std::unordered_map<std::string, bool>*>();
-
-    int depth = 0;      // Depth in scopes, where the variable is found
-    while (!scopes->empty()) {
-        if (
-            scopes->top()->find(*name->lexeme) != 
-            scopes->top()->end()
-        ) {
-            interpreter->resolve(expr, depth);
-            break;
-        } else {
-            tempScopes->push(scopes->top());
-            scopes->pop();
-            depth++;
+    (*scopes->back())[name->interned].defined = true;
+}
+
+void Resolver::resolveLocal(Token* name, Expr::VariableKind* kind, int* slot)
+{
+    // Walking from innermost scope outwards
+    for (int i = scopes->size() - 1; i >= 0; i--) {
+        std::unordered_map<LoxString*, LocalVariable>* scope = scopes->at(i);
+        std::unordered_map<LoxString*, LocalVariable>::iterator found = 
+            scope->find(name->interned);
+
+        if (found == scope->end()) {
+            continue;
         }
+
+        LocalVariable* variable = &found->second;
+
+        if (i >= function->firstScope) {
+            // Local of the function itself, through its cell once captured
+            *kind = variable->captured ? Expr::VARIABLE_CELL : Expr::VARIABLE_LOCAL;
+            *slot = variable->slot;
+
+            variable->kinds.push_back(kind);
+            return;
+        }
+
+        // Declared by an enclosing function, reached through upvalues
+        capture(variable);
+
+        *kind = Expr::VARIABLE_UPVALUE;
+        *slot = resolveUpvalue(function, variable->slot, i);
+        return;
     }
 
-    // If the above whole loop runs and scopes becomes empty
+    // If the above whole loop runs without finding the variable
     // Then the variable in the block is defined in Global scope
+}
+
+int Resolver::resolveUpvalue(FunctionScope* function, int slot, int scopeIndex)
+{
+    FunctionScope* enclosing = function->enclosing;
+
+    if (scopeIndex >= enclosing->firstScope) {
+        return addUpvalue(function, slot, true);
+    }
+
+    // Every function in between captures it too, to hand it down
+    return addUpvalue(function, resolveUpvalue(enclosing, slot, scopeIndex), false);
+}
+
+int Resolver::addUpvalue(FunctionScope* function, int index, bool isLocal)
+{
+    for (unsigned int i = 0; i < function->upvalues.size(); i++) {
+        Stmt::Capture& upvalue = function->upvalues[i];
 
-    // Trasfering all the traveresed scopes back to main scope
-    while (!tempScopes->empty()) {
-        scopes->push(tempScopes->top());
-        tempScopes->pop();
+        if (upvalue.index == index && upvalue.isLocal == isLocal) {
+            return i;
+        }
     }
 
-    delete tempScopes;
+    Stmt::Capture upvalue;
+    upvalue.index = index;
+    upvalue.isLocal = isLocal;
+
+    function->upvalues.push_back(upvalue);
+
+    return function->upvalues.size() - 1;
 }
 
-void Resolver::resolveFunction(Stmt::Function* function, FunctionType type)
+void Resolver::capture(LocalVariable* variable)
+{
+    if (variable->captured) {
+        return;
+    }
+
+    // Uses resolved before the closure now go through the cell too
+    variable->captured = true;
+
+    for (Expr::VariableKind* kind: variable->kinds) {
+        *kind = Expr::VARIABLE_CELL;
+    }
+}
+
+void Resolver::resolveFunction(Stmt::Function* declaration, FunctionType type)
 {
     // We keep track of enclosingFunction as local function can be defined
     // Hence, a track of 'how many' we're in is required
     FunctionType enclosingFunction = currentFunction;
     currentFunction = type;
+    declaresFunctions = true;
+
+    // Each function has a frame of its own
+    FunctionScope scope;
+    scope.enclosing = function;
+    scope.firstScope = scopes->size();
+    scope.slotCount = 0;
+    scope.maxSlots = 0;
+    function = &scope;
 
     beginScope();
 
-    for (Token* param: *function->params) {
-        declare(param);
-        define(param);
+    // Methods get the receiver in slot 0, before the parameters
+    if (type == FunctionType::METHOD || type == FunctionType::INITIALIZER) {
+        LocalVariable* receiver = addLocal(StringTable::global()->intern("this"));
+        receiver->isParameter = true;
+        receiver->defined = true;
+    }
+
+    for (Token* param: *declaration->params) {
+        declareParameter(param);
     }
 
     // In Static analysis, we immediately traverse into body 
     // In runtime, body was touched when the function was called
-    resolve(function->body);
+    resolve(declaration->body);
+
+    std::vector<int> cellParameters;
+    for (std::pair<LoxString* const, LocalVariable>& local: *scopes->back()) {
+        if (local.second.isParameter && local.second.captured) {
+            cellParameters.push_back(local.second.slot);
+        }
+    }
+    std::sort(cellParameters.begin(), cellParameters.end());
 
     endScope();
+
+    declaration->upvalues = arena->makeList(scope.upvalues);
+    declaration->cellParameters = arena->makeList(cellParameters);
+    declaration->slotCount = scope.maxSlots;
+
+    function = scope.enclosing;
     currentFunction = enclosingFunction;
-}
\ No newline at end of file
+}
@@ -0,0 +1,35 @@
+#include "./../../include/VM/Chunk.h"
+
+void Chunk::write(uint8_t byte, int line)
+{
+    if (lines.empty() || lines.back().second != line) {
+        lines.push_back(std::make_pair((int)code.size(), line));
+    }
+
+    code.push_back(byte);
+}
+
+int Chunk::addConstant(Value value)
+{
+    constants.push_back(value);
+    return constants.size() - 1;
+}
+
+int Chunk::getLine(int offset)
+{
+    // Binary search for the last run starting at or before offset
+    int low = 0;
+    int high = lines.size() - 1;
+
+    while (low < high) {
+        int mid = (low + high + 1) / 2;
+
+        if (lines[mid].first <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    return lines.empty() ? 0 : lines[low].second;
+}
@@ -0,0 +1,641 @@
+#include "./../../include/VM/Compiler.h"
+#include "./../../include/VM/VM.h"
+
+// Name of the receiver slot of methods
+static const Source thisSource("this");
+static Token thisToken(TokenType::THIS, &thisSource, 0, 4, 0);
+
+FunctionState::FunctionState(VmFunction* function, FunctionState* enclosing, FunctionType type)
+{
+    this->function = function;
+    this->enclosing = enclosing;
+    this->type = type;
+    this->scopeDepth = 0;
+
+    // Slot zero holds the function being called, or the receiver of a method
+    CompilerLocal callee;
+    callee.name = nullptr;
+
+    if (type == FunctionType::METHOD || type == FunctionType::INITIALIZER) {
+        callee.name = &thisToken;
+    }
+
+    callee.depth = 0;
+    callee.isCaptured = false;
+
+    locals.push_back(callee);
+}
+
+Compiler::Compiler(VM* vm)
+{
+    this->vm = vm;
+    this->current = nullptr;
+    this->line = 1;
+}
+
+VmFunction* Compiler::compile(NodeList<Stmt::Stmt*>* statements)
+{
+    // Compiled objects are never tracked by the heap
+    // They live as long as the program like the syntax tree does
+    VmFunction* script = new VmFunction(nullptr);
+    current = new FunctionState(script, nullptr, FunctionType::NONE);
+
+    for (Stmt::Stmt* statement: *statements) {
+        compile(statement);
+    }
+
+    emitByte(OpCode::OP_NIL);
+    emitByte(OpCode::OP_RETURN);
+
+    delete current;
+    current = nullptr;
+
+    return script;
+}
+
+void Compiler::compile(Stmt::Stmt* stmt)
+{
+    stmt->accept(this);
+}
+
+void Compiler::compile(Expr::Expr* expr)
+{
+    expr->accept(this);
+}
+
+std::string* Compiler::visitLiteralExpr(Expr::Literal* expr)
+{
+    if (expr->value.isNil()) {
+        emitByte(OpCode::OP_NIL);
+    } else if (expr->value.isBool()) {
+        emitByte(expr->value.asBool() ? OpCode::OP_TRUE : OpCode::OP_FALSE);
+    } else {
+        emitConstant(expr->value);
+    }
+
+    return nullptr;
+}
+
+std::string* Compiler::visitGroupingExpr(Expr::Grouping* expr)
+{
+    compile(expr->expression);
+    return nullptr;
+}
+
+std::string* Compiler::visitUnaryExpr(Expr::Unary* expr)
+{
+    compile(expr->right);
+
+    line = expr->operator_->line;
+    switch (expr->operator_->type) {
+        case TokenType::MINUS: emitByte(OpCode::OP_NEGATE); break;
+        case TokenType::BANG: emitByte(OpCode::OP_NOT); break;
+        default: break;
+    }
+
+    return nullptr;
+}
+
+std::string* Compiler::visitBinaryExpr(Expr::Binary* expr)
+{
+    compile(expr->left);
+    compile(expr->right);
+
+    line = expr->operator_->line;
+    switch (expr->operator_->type) {
+        case TokenType::PLUS: emitByte(OpCode::OP_ADD); break;
+        case TokenType::MINUS: emitByte(OpCode::OP_SUBTRACT); break;
+        case TokenType::STAR: emitByte(OpCode::OP_MULTIPLY); break;
+        case TokenType::SLASH: emitByte(OpCode::OP_DIVIDE); break;
+        case TokenType::GREATER: emitByte(OpCode::OP_GREATER); break;
+        case TokenType::GREATER_EQUAL: emitByte(OpCode::OP_GREATER_EQUAL); break;
+        case TokenType::LESS: emitByte(OpCode::OP_LESS); break;
+        case TokenType::LESS_EQUAL: emitByte(OpCode::OP_LESS_EQUAL); break;
+        case TokenType::EQUAL_EQUAL: emitByte(OpCode::OP_EQUAL); break;
+        case TokenType::BANG_EQUAL: emitByte(OpCode::OP_NOT_EQUAL); break;
+        default: break;
+    }
+
+    return nullptr;
+}
+
+std::string* Compiler::visitLogicalExpr(Expr::Logical* expr)
+{
+    compile(expr->left);
+
+    line = expr->operator_->line;
+    if (expr->operator_->type == TokenType::OR) {
+        // Truthy left operand jumps over the right operand
+        int elseJump = emitJump(OpCode::OP_JUMP_IF_FALSE);
+        int endJump = emitJump(OpCode::OP_JUMP);
+
+        patchJump(elseJump);
+        emitByte(OpCode::OP_POP);
+
+        compile(expr->right);
+        patchJump(endJump);
+    } else {
+        // Falsey left operand is the result of and
+        int endJump = emitJump(OpCode::OP_JUMP_IF_FALSE);
+
+        emitByte(OpCode::OP_POP);
+        compile(expr->right);
+
+        patchJump(endJump);
+    }
+
+    return nullptr;
+}
+
+std::string* Compiler::visitVariableExpr(Expr::Variable* expr)
+{
+    namedVariable(expr->name, false);
+    return nullptr;
+}
+
+std::string* Compiler::visitAssignExpr(Expr::Assign* expr)
+{
+    compile(expr->value);
+    namedVariable(expr->name, true);
+
+    return nullptr;
+}
+
+std::string* Compiler::visitCallExpr(Expr::Call* expr)
+{
+    // Method calls skip creating a bound method for the callee
+    if (expr->method != nullptr) {
+        compile(expr->method->object);
+    } else {
+        compile(expr->callee);
+    }
+
+    for (Expr::Expr* argument: *expr->arguments) {
+        compile(argument);
+    }
+
+    line = expr->paren->line;
+
+    // The resolver marks calls whose value is returned right away, the
+    // OP_RETURN after them only runs when the frame was not reused
+    if (expr->method != nullptr) {
+        emitByte(expr->tailCall ? OpCode::OP_TAIL_INVOKE : OpCode::OP_INVOKE);
+        emitShort(identifierConstant(expr->method->name));
+        emitByte(expr->arguments->size());
+    } else {
+        emitBytes(expr->tailCall ? OpCode::OP_TAIL_CALL : OpCode::OP_CALL, expr->arguments->size());
+    }
+
+    return nullptr;
+}
+
+std::string* Compiler::visitGetExpr(Expr::Get* expr)
+{
+    compile(expr->object);
+
+    line = expr->name->line;
+    emitByte(OpCode::OP_GET_PROPERTY);
+    emitShort(identifierConstant(expr->name));
+
+    return nullptr;
+}
+
+std::string* Compiler::visitSetExpr(Expr::Set* expr)
+{
+    compile(expr->object);
+    compile(expr->value);
+
+    line = expr->name->line;
+    emitByte(OpCode::OP_SET_PROPERTY);
+    emitShort(identifierConstant(expr->name));
+
+    return nullptr;
+}
+
+std::string* Compiler::visitThisExpr(Expr::This* expr)
+{
+    namedVariable(expr->keyword, false);
+    return nullptr;
+}
+
+void* Compiler::visitExpressionStmt(Stmt::Expression* stmt)
+{
+    compile(stmt->expression);
+    emitByte(OpCode::OP_POP);
+
+    return nullptr;
+}
+
+void* Compiler::visitPrintStmt(Stmt::Print* stmt)
+{
+    compile(stmt->expression);
+    emitByte(OpCode::OP_PRINT);
+
+    return nullptr;
+}
+
+void* Compiler::visitVarStmt(Stmt::Var* stmt)
+{
+    line = stmt->name->line;
+    declareVariable(stmt->name);
+
+    if (stmt->initializer != nullptr) {
+        compile(stmt->initializer);
+    } else {
+        emitByte(OpCode::OP_NIL);
+    }
+
+    defineVariable(stmt->name);
+    return nullptr;
+}
+
+void* Compiler::visitBlockStmt(Stmt::Block* stmt)
+{
+    beginScope();
+
+    for (Stmt::Stmt* statement: *stmt->statements) {
+        compile(statement);
+    }
+
+    endScope();
+    return nullptr;
+}
+
+void* Compiler::visitIfStmt(Stmt::If* stmt)
+{
+    compile(stmt->condition);
+
+    int thenJump = emitJump(OpCode::OP_JUMP_IF_FALSE);
+    emitByte(OpCode::OP_POP);
+    compile(stmt->thenBranch);
+
+    int elseJump = emitJump(OpCode::OP_JUMP);
+
+    patchJump(thenJump);
+    emitByte(OpCode::OP_POP);
+
+    if (stmt->elseBranch != nullptr) {
+        compile(stmt->elseBranch);
+    }
+
+    patchJump(elseJump);
+    return nullptr;
+}
+
+void* Compiler::visitWhileStmt(Stmt::While* stmt)
+{
+    int loopStart = currentChunk()->code.size();
+
+    compile(stmt->condition);
+
+    int exitJump = emitJump(OpCode::OP_JUMP_IF_FALSE);
+    emitByte(OpCode::OP_POP);
+    compile(stmt->body);
+    emitLoop(loopStart);
+
+    patchJump(exitJump);
+    emitByte(OpCode::OP_POP);
+
+    return nullptr;
+}
+
+void* Compiler::visitFunctionStmt(Stmt::Function* stmt)
+{
+    line = stmt->name->line;
+    declareVariable(stmt->name);
+
+    // Function can refer to itself inside its body for recursion
+    markInitialized();
+
+    compileFunction(stmt, FunctionType::FUNCTION);
+    defineVariable(stmt->name);
+
+    return nullptr;
+}
+
+void* Compiler::visitReturnStmt(Stmt::Return* stmt)
+{
+    line = stmt->keyword->line;
+
+    if (stmt->value != nullptr) {
+        compile(stmt->value);
+        emitByte(OpCode::OP_RETURN);
+    } else {
+        emitReturn();
+    }
+
+    return nullptr;
+}
+
+void* Compiler::visitClassStmt(Stmt::Class* stmt)
+{
+    line = stmt->name->line;
+    declareVariable(stmt->name);
+
+    emitByte(OpCode::OP_CLASS);
+    emitShort(identifierConstant(stmt->name));
+
+    defineVariable(stmt->name);
+
+    // Class is loaded again so each method closure can be added to it
+    namedVariable(stmt->name, false);
+
+    for (Stmt::Function* method: *stmt->methods) {
+        FunctionType type = FunctionType::METHOD;
+
+        if (method->name->lexemeEquals("init")) {
+            type = FunctionType::INITIALIZER;
+        }
+
+        line = method->name->line;
+        compileFunction(method, type);
+
+        emitByte(OpCode::OP_METHOD);
+        emitShort(identifierConstant(method->name));
+    }
+
+    emitByte(OpCode::OP_POP);
+    return nullptr;
+}
+
+void Compiler::compileFunction(Stmt::Function* stmt, FunctionType type)
+{
+    VmFunction* function = new VmFunction(new LoxString(stmt->name->lexeme()));
+    function->arity = stmt->params->size();
+
+    FunctionState* state = new FunctionState(function, current, type);
+    current = state;
+
+    // Parameters and body share the function's outermost scope
+    beginScope();
+
+    for (Token* param: *stmt->params) {
+        declareVariable(param);
+        defineVariable(param);
+    }
+
+    for (Stmt::Stmt* statement: *stmt->body) {
+        compile(statement);
+    }
+
+    // Implicit return when the body falls off the end
+    emitReturn();
+
+    function->upvalueCount = state->upvalues.size();
+    current = state->enclosing;
+
+    emitByte(OpCode::OP_CLOSURE);
+    emitShort(makeConstant(Value::fromObject(function)));
+
+    for (CompilerUpvalue upvalue: state->upvalues) {
+        emitBytes(upvalue.isLocal ? 1 : 0, upvalue.index);
+    }
+
+    delete state;
+}
+
+Chunk* Compiler::currentChunk()
+{
+    return &current->function->chunk;
+}
+
+void Compiler::emitByte(uint8_t byte)
+{
+    currentChunk()->write(byte, line);
+}
+
+void Compiler::emitBytes(uint8_t first, uint8_t second)
+{
+    emitByte(first);
+    emitByte(second);
+}
+
+void Compiler::emitShort(uint16_t value)
+{
+    emitBytes((value >> 8) & 0xff, value & 0xff);
+}
+
+void Compiler::emitConstant(Value value)
+{
+    emitByte(OpCode::OP_CONSTANT);
+    emitShort(makeConstant(value));
+}
+
+void Compiler::emitReturn()
+{
+    if (current->type == FunctionType::INITIALIZER) {
+        emitBytes(OpCode::OP_GET_LOCAL, 0);
+    } else {
+        emitByte(OpCode::OP_NIL);
+    }
+
+    emitByte(OpCode::OP_RETURN);
+}
+
+uint16_t Compiler::makeConstant(Value value)
+{
+    int constant = currentChunk()->addConstant(value);
+
+    if (constant > UINT16_MAX) {
+        Lox::error(line, "Too many constants in one chunk.");
+        return 0;
+    }
+
+    return constant;
+}
+
+uint16_t Compiler::globalSlot(Token* name)
+{
+    int slot = vm->globalSlot(name->lexeme());
+
+    if (slot > UINT16_MAX) {
+        Lox::error(name, "Too many global variables.");
+        return 0;
+    }
+
+    return slot;
+}
+
+uint16_t Compiler::identifierConstant(Token* name)
+{
+    // Interned, so the VM finds fields and methods by pointer
+    return makeConstant(Value::fromObject(name->interned));
+}
+
+int Compiler::emitJump(uint8_t instruction)
+{
+    emitByte(instruction);
+
+    // Placeholder offset, filled by patchJump
+    emitByte(0xff);
+    emitByte(0xff);
+
+    return currentChunk()->code.size() - 2;
+}
+
+void Compiler::patchJump(int offset)
+{
+    // -2 to adjust for the jump offset itself
+    int jump = currentChunk()->code.size() - offset - 2;
+
+    if (jump > UINT16_MAX) {
+        Lox::error(line, "Too much code to jump over.");
+    }
+
+    currentChunk()->code[offset] = (jump >> 8) & 0xff;
+    currentChunk()->code[offset + 1] = jump & 0xff;
+}
+
+void Compiler::emitLoop(int loopStart)
+{
+    emitByte(OpCode::OP_LOOP);
+
+    // +2 to jump over the operand of OP_LOOP too
+    int offset = currentChunk()->code.size() - loopStart + 2;
+    if (offset > UINT16_MAX) {
+        Lox::error(line, "Loop body too large.");
+    }
+
+    emitShort(offset);
+}
+
+void Compiler::beginScope()
+{
+    current->scopeDepth++;
+}
+
+void Compiler::endScope()
+{
+    current->scopeDepth--;
+
+    // Discarding locals of the scope, captured ones move to the heap
+    while (
+        !current->locals.empty() &&
+        current->locals.back().depth > current->scopeDepth
+    ) {
+        if (current->locals.back().isCaptured) {
+            emitByte(OpCode::OP_CLOSE_UPVALUE);
+        } else {
+            emitByte(OpCode::OP_POP);
+        }
+
+        current->locals.pop_back();
+    }
+}
+
+void Compiler::declareVariable(Token* name)
+{
+    // Globals are bound by defineVariable
+    if (current->scopeDepth == 0) {
+        return;
+    }
+
+    if (current->locals.size() > UINT8_MAX) {
+        Lox::error(name, "Too many local variables in function.");
+        return;
+    }
+
+    // Redeclaration in the same scope is already reported by the resolver
+    CompilerLocal local;
+    local.name = name;
+    local.depth = -1;
+    local.isCaptured = false;
+
+    current->locals.push_back(local);
+}
+
+void Compiler::markInitialized()
+{
+    if (current->scopeDepth == 0) {
+        return;
+    }
+
+    current->locals.back().depth = current->scopeDepth;
+}
+
+void Compiler::defineVariable(Token* name)
+{
+    if (current->scopeDepth > 0) {
+        // Local already sits in its stack slot
+        markInitialized();
+        return;
+    }
+
+    emitByte(OpCode::OP_DEFINE_GLOBAL);
+    emitShort(globalSlot(name));
+}
+
+void Compiler::namedVariable(Token* name, bool isAssignment)
+{
+    line = name->line;
+
+    int arg = resolveLocal(current, name);
+    if (arg != -1) {
+        emitBytes(isAssignment ? OpCode::OP_SET_LOCAL : OpCode::OP_GET_LOCAL, arg);
+        return;
+    }
+
+    arg = resolveUpvalue(current, name);
+    if (arg != -1) {
+        emitBytes(isAssignment ? OpCode::OP_SET_UPVALUE : OpCode::OP_GET_UPVALUE, arg);
+        return;
+    }
+
+    emitByte(isAssignment ? OpCode::OP_SET_GLOBAL : OpCode::OP_GET_GLOBAL);
+    emitShort(globalSlot(name));
+}
+
+int Compiler::resolveLocal(FunctionState* state, Token* name)
+{
+    for (int i = state->locals.size() - 1; i >= 0; i--) {
+        CompilerLocal& local = state->locals[i];
+
+        if (local.name != nullptr && local.name->lexemeEquals(name)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int Compiler::resolveUpvalue(FunctionState* state, Token* name)
+{
+    if (state->enclosing == nullptr) {
+        return -1;
+    }
+
+    int local = resolveLocal(state->enclosing, name);
+    if (local != -1) {
+        state->enclosing->locals[local].isCaptured = true;
+        return addUpvalue(state, local, true);
+    }
+
+    // Capturing an upvalue of the enclosing function instead
+    int upvalue = resolveUpvalue(state->enclosing, name);
+    if (upvalue != -1) {
+        return addUpvalue(state, upvalue, false);
+    }
+
+    return -1;
+}
+
+int Compiler::addUpvalue(FunctionState* state, uint8_t index, bool isLocal)
+{
+    for (unsigned int i = 0; i < state->upvalues.size(); i++) {
+        if (state->upvalues[i].index == index && state->upvalues[i].isLocal == isLocal) {
+            return i;
+        }
+    }
+
+    if (state->upvalues.size() > UINT8_MAX) {
+        Lox::error(line, "Too many closure variables in function.");
+        return 0;
+    }
+
+    CompilerUpvalue upvalue;
+    upvalue.index = index;
+    upvalue.isLocal = isLocal;
+
+    state->upvalues.push_back(upvalue);
+    return state->upvalues.size() - 1;
+}
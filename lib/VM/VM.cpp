@@ -0,0 +1,638 @@
+#include "./../../include/VM/VM.h"
+#include "./../../include/Native/Clock.h"
+#include "./../../include/Native/Flush.h"
+#include "./../../include/Lox.h"
+
+VM::VM()
+{
+    this->heap = new Heap();
+    this->heap->setRootProvider(this);
+
+    // Slots are always pushed before they are read, left uninitialized so the
+    // system only commits the pages that deep recursion actually reaches
+    this->stack = static_cast<Value*>(::operator new(sizeof(Value) * STACK_MAX));
+    this->frames = new CallFrame[FRAMES_MAX];
+    resetStack();
+
+    this->globalSlots = new std::unordered_map<std::string, int>();
+    this->globalNames = new std::vector<std::string>();
+    this->globals = new std::vector<Value>();
+    this->globalDefined = new std::vector<bool>();
+
+    defineNative("clock", new Clock());
+    defineNative("flush", new Flush());
+}
+
+void VM::defineNative(std::string name, LoxCallable* native)
+{
+    int slot = globalSlot(name);
+
+    (*globals)[slot] = Value::fromObject(native);
+    (*globalDefined)[slot] = true;
+}
+
+int VM::globalSlot(const std::string& name)
+{
+    std::unordered_map<std::string, int>::iterator it = globalSlots->find(name);
+    if (it != globalSlots->end()) {
+        return it->second;
+    }
+
+    int slot = globals->size();
+
+    (*globalSlots)[name] = slot;
+    globalNames->push_back(name);
+    globals->push_back(Value());
+    globalDefined->push_back(false);
+
+    return slot;
+}
+
+void VM::interpret(NodeList<Stmt::Stmt*>* statements)
+{
+    Compiler compiler(this);
+    VmFunction* script = compiler.compile(statements);
+
+    if (Lox::hadError) {
+        return;
+    }
+
+    VmClosure* closure = heap->track(new VmClosure(script));
+    push(Value::fromObject(closure));
+    call(closure, 0, false);
+
+    run();
+}
+
+void VM::markRoots(Heap* heap)
+{
+    for (Value* slot = stack; slot < stackTop; slot++) {
+        heap->markValue(*slot);
+    }
+
+    for (int i = 0; i < frameCount; i++) {
+        heap->markObject(frames[i].closure);
+    }
+
+    for (VmUpvalue* upvalue = openUpvalues; upvalue != nullptr; upvalue = upvalue->nextOpen) {
+        heap->markObject(upvalue);
+    }
+
+    for (Value value: *globals) {
+        heap->markValue(value);
+    }
+}
+
+bool VM::run()
+{
+    CallFrame* frame = &frames[frameCount - 1];
+
+    // Operand decoding, u16 operands are stored big endian
+    #define READ_BYTE() (*frame->ip++)
+    #define READ_SHORT() (frame->ip += 2, (uint16_t)((frame->ip[-2] << 8) | frame->ip[-1]))
+    #define READ_CONSTANT() (frame->closure->function->chunk.constants[READ_SHORT()])
+    #define READ_STRING() ((LoxString*)READ_CONSTANT().asObject())
+
+    #define BINARY_OP(valueType, op) \
+        do { \
+            if (!peek(0).isNumber() || !peek(1).isNumber()) { \
+                runtimeError("Operands must be numbers."); \
+                return false; \
+            } \
+            double b = pop().asNumber(); \
+            double a = pop().asNumber(); \
+            push(valueType(a op b)); \
+        } while (false)
+
+    while (true) {
+        uint8_t instruction = READ_BYTE();
+
+        switch (instruction) {
+            case OpCode::OP_CONSTANT:
+                push(READ_CONSTANT());
+                break;
+
+            case OpCode::OP_NIL: push(Value()); break;
+            case OpCode::OP_TRUE: push(Value::fromBool(true)); break;
+            case OpCode::OP_FALSE: push(Value::fromBool(false)); break;
+            case OpCode::OP_POP: pop(); break;
+
+            case OpCode::OP_GET_LOCAL: {
+                uint8_t slot = READ_BYTE();
+                push(frame->slots[slot]);
+                break;
+            }
+
+            case OpCode::OP_SET_LOCAL: {
+                uint8_t slot = READ_BYTE();
+                frame->slots[slot] = peek(0);
+                break;
+            }
+
+            case OpCode::OP_GET_GLOBAL: {
+                uint16_t slot = READ_SHORT();
+
+                if (!(*globalDefined)[slot]) {
+                    runtimeError("Undefined variable '" + (*globalNames)[slot] + "'.");
+                    return false;
+                }
+
+                push((*globals)[slot]);
+                break;
+            }
+
+            case OpCode::OP_DEFINE_GLOBAL: {
+                uint16_t slot = READ_SHORT();
+
+                (*globals)[slot] = peek(0);
+                (*globalDefined)[slot] = true;
+                pop();
+                break;
+            }
+
+            case OpCode::OP_SET_GLOBAL: {
+                uint16_t slot = READ_SHORT();
+
+                if (!(*globalDefined)[slot]) {
+                    runtimeError("Undefined variable '" + (*globalNames)[slot] + "'.");
+                    return false;
+                }
+
+                (*globals)[slot] = peek(0);
+                break;
+            }
+
+            case OpCode::OP_GET_UPVALUE: {
+                uint8_t slot = READ_BYTE();
+                push(*frame->closure->upvalues[slot]->location);
+                break;
+            }
+
+            case OpCode::OP_SET_UPVALUE: {
+                uint8_t slot = READ_BYTE();
+                *frame->closure->upvalues[slot]->location = peek(0);
+                break;
+            }
+
+            case OpCode::OP_GET_PROPERTY: {
+                LoxString* name = READ_STRING();
+
+                if (!peek(0).isInstance()) {
+                    runtimeError("Only instances have properties.");
+                    return false;
+                }
+
+                Value field;
+                if (peek(0).asInstance()->getField(name, &field)) {
+                    pop();
+                    push(field);
+                    break;
+                }
+
+                if (!bindMethod(peek(0).asInstance()->klass, name)) {
+                    return false;
+                }
+
+                break;
+            }
+
+            case OpCode::OP_SET_PROPERTY: {
+                LoxString* name = READ_STRING();
+
+                if (!peek(1).isInstance()) {
+                    runtimeError("Only instances have fields.");
+                    return false;
+                }
+
+                peek(1).asInstance()->setField(name, peek(0));
+                heap->grew(peek(1).asInstance());
+
+                // Assignment evaluates to the assigned value
+                Value value = pop();
+                pop();
+                push(value);
+                break;
+            }
+
+            case OpCode::OP_EQUAL: {
+                Value b = pop();
+                Value a = pop();
+                push(Value::fromBool(a.equals(b)));
+                break;
+            }
+
+            case OpCode::OP_NOT_EQUAL: {
+                Value b = pop();
+                Value a = pop();
+                push(Value::fromBool(!a.equals(b)));
+                break;
+            }
+
+            case OpCode::OP_GREATER: BINARY_OP(Value::fromBool, >); break;
+            case OpCode::OP_GREATER_EQUAL: BINARY_OP(Value::fromBool, >=); break;
+            case OpCode::OP_LESS: BINARY_OP(Value::fromBool, <); break;
+            case OpCode::OP_LESS_EQUAL: BINARY_OP(Value::fromBool, <=); break;
+            case OpCode::OP_SUBTRACT: BINARY_OP(Value::fromNumber, -); break;
+            case OpCode::OP_MULTIPLY: BINARY_OP(Value::fromNumber, *); break;
+            case OpCode::OP_DIVIDE: BINARY_OP(Value::fromNumber, /); break;
+
+            case OpCode::OP_ADD: {
+                Value b = peek(0);
+                Value a = peek(1);
+
+                if (a.isNumber() && b.isNumber()) {
+                    pop();
+                    pop();
+                    push(Value::fromNumber(a.asNumber() + b.asNumber()));
+                } else if (a.isString() || b.isString()) {
+                    // Operands stay on the stack while the result is allocated
+                    LoxString* result;
+                    if (a.isString() && b.isString()) {
+                        result = LoxString::concatenate(heap, a.asString(), b.asString());
+                    } else if (a.isString()) {
+                        result = LoxString::concatenate(heap, a.asString(), b.toString());
+                    } else {
+                        result = heap->track(new LoxString(a.toString() + b.toString()));
+                    }
+
+                    pop();
+                    pop();
+                    push(Value::fromObject(result));
+                } else {
+                    runtimeError("Operands must be two numbers or two strings.");
+                    return false;
+                }
+
+                break;
+            }
+
+            case OpCode::OP_NOT:
+                push(Value::fromBool(!isTruthy(pop())));
+                break;
+
+            case OpCode::OP_NEGATE:
+                if (!peek(0).isNumber()) {
+                    runtimeError("Operand must be a number.");
+                    return false;
+                }
+
+                push(Value::fromNumber(-pop().asNumber()));
+                break;
+
+            case OpCode::OP_PRINT:
+                Lox::output->print(pop());
+                break;
+
+            case OpCode::OP_JUMP: {
+                uint16_t offset = READ_SHORT();
+                frame->ip += offset;
+                break;
+            }
+
+            case OpCode::OP_JUMP_IF_FALSE: {
+                uint16_t offset = READ_SHORT();
+
+                if (!isTruthy(peek(0))) {
+                    frame->ip += offset;
+                }
+
+                break;
+            }
+
+            case OpCode::OP_LOOP: {
+                uint16_t offset = READ_SHORT();
+                frame->ip -= offset;
+                break;
+            }
+
+            case OpCode::OP_CALL:
+            case OpCode::OP_TAIL_CALL: {
+                bool tail = instruction == OpCode::OP_TAIL_CALL;
+                int argCount = READ_BYTE();
+
+                if (!callValue(peek(argCount), argCount, tail)) {
+                    return false;
+                }
+
+                frame = &frames[frameCount - 1];
+                break;
+            }
+
+            case OpCode::OP_INVOKE:
+            case OpCode::OP_TAIL_INVOKE: {
+                bool tail = instruction == OpCode::OP_TAIL_INVOKE;
+                LoxString* name = READ_STRING();
+                int argCount = READ_BYTE();
+
+                if (!invoke(name, argCount, tail)) {
+                    return false;
+                }
+
+                frame = &frames[frameCount - 1];
+                break;
+            }
+
+            case OpCode::OP_CLOSURE: {
+                VmFunction* function = (VmFunction*)READ_CONSTANT().asObject();
+                VmClosure* closure = heap->track(new VmClosure(function));
+
+                // Reachable from the stack while its upvalues are allocated
+                push(Value::fromObject(closure));
+
+                for (int i = 0; i < function->upvalueCount; i++) {
+                    uint8_t isLocal = READ_BYTE();
+                    uint8_t index = READ_BYTE();
+
+                    if (isLocal) {
+                        closure->upvalues[i] = captureUpvalue(frame->slots + index);
+                    } else {
+                        closure->upvalues[i] = frame->closure->upvalues[index];
+                    }
+                }
+
+                break;
+            }
+
+            case OpCode::OP_CLOSE_UPVALUE:
+                closeUpvalues(stackTop - 1);
+                pop();
+                break;
+
+            case OpCode::OP_RETURN: {
+                Value result = pop();
+                closeUpvalues(frame->slots);
+
+                frameCount--;
+                if (frameCount == 0) {
+                    // Popping the script closure
+                    pop();
+                    return true;
+                }
+
+                stackTop = frame->slots;
+                push(result);
+
+                frame = &frames[frameCount - 1];
+                break;
+            }
+
+            case OpCode::OP_CLASS: {
+                LoxString* name = READ_STRING();
+                push(Value::fromObject(heap->track(new LoxClass(name->text()))));
+                break;
+            }
+
+            case OpCode::OP_METHOD: {
+                LoxString* name = READ_STRING();
+                LoxClass* klass = (LoxClass*)peek(1).asObject();
+
+                (*klass->methods)[name] = peek(0).asObject();
+                pop();
+                break;
+            }
+        }
+    }
+
+    #undef READ_BYTE
+    #undef READ_SHORT
+    #undef READ_CONSTANT
+    #undef READ_STRING
+    #undef BINARY_OP
+}
+
+void VM::push(Value value)
+{
+    *stackTop = value;
+    stackTop++;
+}
+
+Value VM::pop()
+{
+    stackTop--;
+    return *stackTop;
+}
+
+Value VM::peek(int distance)
+{
+    return stackTop[-1 - distance];
+}
+
+void VM::resetStack()
+{
+    stackTop = stack;
+    frameCount = 0;
+    openUpvalues = nullptr;
+}
+
+bool VM::callValue(Value callee, int argCount, bool tail)
+{
+    if (callee.isObject()) {
+        switch (callee.asObject()->type) {
+            case ObjectType::OBJ_VM_CLOSURE:
+                return call((VmClosure*)callee.asObject(), argCount, tail);
+
+            case ObjectType::OBJ_NATIVE: {
+                LoxCallable* native = callee.asCallable();
+                if (!checkArity(native->arity(), argCount)) {
+                    return false;
+                }
+
+                // Natives read their arguements where they are on the stack
+                Value result = native->call(nullptr, ArgumentSpan(stackTop - argCount, argCount));
+
+                stackTop -= argCount + 1;
+                push(result);
+                return true;
+            }
+
+            case ObjectType::OBJ_BOUND_METHOD: {
+                LoxBoundMethod* bound = (LoxBoundMethod*)callee.asObject();
+
+                // Receiver takes the callee slot, which is 'this' of the method
+                stackTop[-argCount - 1] = bound->receiver;
+                return call((VmClosure*)bound->method, argCount, tail);
+            }
+
+            case ObjectType::OBJ_CLASS: {
+                LoxClass* klass = (LoxClass*)callee.asObject();
+                LoxInstance* instance = heap->track(new LoxInstance(klass));
+
+                // Initializer runs with the new instance as its receiver
+                stackTop[-argCount - 1] = Value::fromObject(instance);
+
+                LoxObject* initializer = klass->findMethod(LoxClass::initializerName());
+                if (initializer != nullptr) {
+                    return call((VmClosure*)initializer, argCount, tail);
+                }
+
+                if (!checkArity(0, argCount)) {
+                    return false;
+                }
+
+                stackTop -= argCount;
+                return true;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    runtimeError("Can only call functions and classes.");
+    return false;
+}
+
+bool VM::call(VmClosure* closure, int argCount, bool tail)
+{
+    if (!checkArity(closure->function->arity, argCount)) {
+        return false;
+    }
+
+    if (tail) {
+        // Nothing of the caller is needed after the call, so the callee and
+        // its arguements move down over its slots and the frame is reused
+        CallFrame* frame = &frames[frameCount - 1];
+        closeUpvalues(frame->slots);
+
+        Value* callee = stackTop - argCount - 1;
+        std::copy(callee, stackTop, frame->slots);
+        stackTop = frame->slots + argCount + 1;
+
+        frame->closure = closure;
+        frame->ip = closure->function->chunk.code.data();
+        return true;
+    }
+
+    if (frameCount == FRAMES_MAX) {
+        runtimeError("Stack overflow.");
+        return false;
+    }
+
+    CallFrame* frame = &frames[frameCount++];
+    frame->closure = closure;
+    frame->ip = closure->function->chunk.code.data();
+    frame->slots = stackTop - argCount - 1;
+
+    return true;
+}
+
+bool VM::invoke(LoxString* name, int argCount, bool tail)
+{
+    Value receiver = peek(argCount);
+
+    if (!receiver.isInstance()) {
+        runtimeError("Only instances have properties.");
+        return false;
+    }
+
+    LoxInstance* instance = receiver.asInstance();
+
+    // Fields shadow methods
+    Value field;
+    if (instance->getField(name, &field)) {
+        stackTop[-argCount - 1] = field;
+        return callValue(field, argCount, tail);
+    }
+
+    LoxObject* method = instance->klass->findMethod(name);
+    if (method == nullptr) {
+        runtimeError("Undefined property '" + name->text() + "'.");
+        return false;
+    }
+
+    return call((VmClosure*)method, argCount, tail);
+}
+
+bool VM::bindMethod(LoxClass* klass, LoxString* name)
+{
+    LoxObject* method = klass->findMethod(name);
+
+    if (method == nullptr) {
+        runtimeError("Undefined property '" + name->text() + "'.");
+        return false;
+    }
+
+    LoxBoundMethod* bound = heap->track(new LoxBoundMethod(peek(0), method));
+
+    pop();
+    push(Value::fromObject(bound));
+    return true;
+}
+
+bool VM::checkArity(int arity, int argCount)
+{
+    if (argCount == arity) {
+        return true;
+    }
+
+    runtimeError(
+        "Exprected " + std::to_string(arity) + " arguements but got " +
+        std::to_string(argCount) + "."
+    );
+
+    return false;
+}
+
+VmUpvalue* VM::captureUpvalue(Value* local)
+{
+    VmUpvalue* previous = nullptr;
+    VmUpvalue* upvalue = openUpvalues;
+
+    while (upvalue != nullptr && upvalue->location > local) {
+        previous = upvalue;
+        upvalue = upvalue->nextOpen;
+    }
+
+    // Closures capturing the same variable share its upvalue
+    if (upvalue != nullptr && upvalue->location == local) {
+        return upvalue;
+    }
+
+    VmUpvalue* created = heap->track(new VmUpvalue(local));
+    created->nextOpen = upvalue;
+
+    if (previous == nullptr) {
+        openUpvalues = created;
+    } else {
+        previous->nextOpen = created;
+    }
+
+    return created;
+}
+
+void VM::closeUpvalues(Value* last)
+{
+    while (openUpvalues != nullptr && openUpvalues->location >= last) {
+        VmUpvalue* upvalue = openUpvalues;
+
+        upvalue->closed = *upvalue->location;
+        upvalue->location = &upvalue->closed;
+
+        openUpvalues = upvalue->nextOpen;
+    }
+}
+
+bool VM::isTruthy(Value value)
+{
+    // nil and false are falsey, everything else is truthy
+    if (value.isNil()) {
+        return false;
+    }
+
+    if (value.isBool()) {
+        return value.asBool();
+    }
+
+    return true;
+}
+
+void VM::runtimeError(std::string message)
+{
+    CallFrame* frame = &frames[frameCount - 1];
+
+    // ip already moved past the failing instruction
+    int offset = frame->ip - frame->closure->function->chunk.code.data() - 1;
+    Lox::runtimeError(frame->closure->function->chunk.getLine(offset), message);
+
+    resetStack();
+}
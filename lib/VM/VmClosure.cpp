@@ -0,0 +1,29 @@
+#include "./../../include/VM/VmClosure.h"
+#include "./../../include/Interpreter/Heap.h"
+
+VmClosure::VmClosure(VmFunction* function) : LoxObject(ObjectType::OBJ_VM_CLOSURE)
+{
+    this->function = function;
+
+    // Filled by OP_CLOSURE right after creation
+    this->upvalues.resize(function->upvalueCount, nullptr);
+}
+
+std::string VmClosure::toString()
+{
+    return function->toString();
+}
+
+void VmClosure::trace(Heap* heap)
+{
+    heap->markObject(function);
+
+    for (VmUpvalue* upvalue: upvalues) {
+        heap->markObject(upvalue);
+    }
+}
+
+std::size_t VmClosure::size()
+{
+    return sizeof(VmClosure) + upvalues.capacity() * sizeof(VmUpvalue*);
+}
@@ -0,0 +1,33 @@
+#include "./../../include/VM/VmFunction.h"
+#include "./../../include/Interpreter/Heap.h"
+
+VmFunction::VmFunction(LoxString* name) : LoxObject(ObjectType::OBJ_VM_FUNCTION)
+{
+    this->arity = 0;
+    this->upvalueCount = 0;
+    this->name = name;
+}
+
+std::string VmFunction::toString()
+{
+    if (name == nullptr) {
+        return "<script>";
+    }
+
+    return "<fn " + name->text() + ">";
+}
+
+void VmFunction::trace(Heap* heap)
+{
+    heap->markObject(name);
+
+    for (Value constant: chunk.constants) {
+        heap->markValue(constant);
+    }
+}
+
+std::size_t VmFunction::size()
+{
+    return sizeof(VmFunction) + chunk.code.capacity() + 
+        chunk.constants.capacity() * sizeof(Value);
+}
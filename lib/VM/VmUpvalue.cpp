@@ -0,0 +1,24 @@
+#include "./../../include/VM/VmUpvalue.h"
+#include "./../../include/Interpreter/Heap.h"
+
+VmUpvalue::VmUpvalue(Value* location) : LoxObject(ObjectType::OBJ_VM_UPVALUE)
+{
+    this->location = location;
+    this->nextOpen = nullptr;
+}
+
+std::string VmUpvalue::toString()
+{
+    return "upvalue";
+}
+
+void VmUpvalue::trace(Heap* heap)
+{
+    // Open upvalues point into the stack which is already a root
+    heap->markValue(closed);
+}
+
+std::size_t VmUpvalue::size()
+{
+    return sizeof(VmUpvalue);
+}
@@ -6,18 +6,130 @@
 
 #include "./../include/Lox.h"
 
+void usage()
+{
+    std::cout << "Usage: jlox [options] [script]" << std::endl;
+    std::cout << "A script of - is read from the standard input" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --vm                  Run on the bytecode virtual machine" << std::endl;
+    std::cout << "  --closures            Compile the syntax tree into closures before running it" << std::endl;
+    std::cout << "  --no-jit              Never compile hot functions to machine code" << std::endl;
+    std::cout << "  --opt-stats           Report constants folded and branches pruned before running" << std::endl;
+    std::cout << "  --gc-stats            Report garbage collector pauses and reclaimed bytes at exit" << std::endl;
+    std::cout << "  --gc-growth=<factor>  Heap growth before the next collection (default 2)" << std::endl;
+    std::cout << "  --gc-threshold=<n>    Minimum heap size in bytes before collecting (default 1MB)" << std::endl;
+    std::cout << "  --output=<file>       Write printed values to a file instead of stdout" << std::endl;
+    std::cout << "  --async-output        Write printed values from a background thread" << std::endl;
+    std::cout << "  --memory-output       Keep printed values in memory and write them to stdout at exit" << std::endl;
+    std::cout << "  --timings             Report time spent loading, compiling and running the script" << std::endl;
+    exit(1);
+}
+
+// Set by --memory-output, Lox::output owns it
+static MemoryTarget* memoryOutput = nullptr;
+
+// Runs on exit() too, which is how scripts with errors end
+void writeMemoryOutput()
+{
+    FileTarget standardOutput;
+    standardOutput.write(memoryOutput->contents.data(), memoryOutput->contents.length());
+}
+
 int main(int argc, char** argv)
 {
-    if (argc > 2) {
-        std::cout << "Usage: jlox [script]" << std::endl;
-        exit(1);
-    } else if (argc == 2) {
-        // If File path is provided
-        Lox::runFile(argv[1]);
-    } else {
-        // Running an Interactive Console - REPL
-        Lox::runPrompt();
+    char* script = nullptr;
+
+    // Options are collected first since they apply to the heap of the selected backend
+    bool useVm = false;
+    bool useClosures = false;
+    bool useJit = true;
+    bool reportStats = false;
+    double growthFactor = 0;
+    long threshold = -1;
+    // Replacing a target deletes it, so only one can be given
+    bool outputSet = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--vm") {
+            useVm = true;
+        } else if (arg == "--closures") {
+            useClosures = true;
+        } else if (arg == "--no-jit") {
+            useJit = false;
+        } else if (arg == "--opt-stats") {
+            Lox::optimizer->reportStats = true;
+        } else if (arg == "--gc-stats") {
+            reportStats = true;
+        } else if (arg.compare(0, 12, "--gc-growth=") == 0) {
+            double factor = ::atof(arg.c_str() + 12);
+            if (factor < 1.0) {
+                usage();
+            }
+            growthFactor = factor;
+        } else if (arg.compare(0, 15, "--gc-threshold=") == 0) {
+            threshold = ::atol(arg.c_str() + 15);
+        } else if (arg.compare(0, 9, "--output=") == 0) {
+            if (outputSet) {
+                usage();
+            }
+            outputSet = true;
+
+            std::string error;
+            FileTarget* target = new FileTarget(arg.substr(9), &error);
+
+            if (!error.empty()) {
+                std::cerr << error << std::endl;
+                exit(1);
+            }
+
+            Lox::output->setTarget(target);
+        } else if (arg == "--async-output") {
+            Lox::output->startWriter();
+        } else if (arg == "--memory-output") {
+            if (outputSet) {
+                usage();
+            }
+            outputSet = true;
+
+            memoryOutput = new MemoryTarget();
+            Lox::output->setTarget(memoryOutput);
+            std::atexit(writeMemoryOutput);
+        } else if (arg == "--timings") {
+            Lox::reportTimings = true;
+        } else if (arg.compare(0, 2, "--") == 0 || script != nullptr) {
+            usage();
+        } else {
+            script = argv[i];
+        }
     }
 
+    if (useVm && useClosures) {
+        usage();
+    }
+
+    if (useVm) {
+        Lox::vm = new VM();
+    }
+
+    // Compiled closures run on the interpreter's state, so its heap options apply
+    if (useClosures) {
+        Lox::closureCompiler = new ClosureCompiler(Lox::interpreter);
+    }
+
+    Lox::interpreter->jit->enabled = useJit;
+
+    Heap* heap = useVm ? Lox::vm->heap : Lox::interpreter->heap;
+    heap->reportStats = reportStats;
+    if (growthFactor > 0) {
+        heap->growthFactor = growthFactor;
+    }
+    if (threshold >= 0) {
+        heap->minimumThreshold = threshold;
+    }
+
+    Lox::runSession(script);
+
     return 0;
-}
\ No newline at end of file
+}